@@ -193,6 +193,8 @@ static int sendMessage0(Dict* message, String* txid, struct Admin* adminPub, int
         int index = Map_LastMessageTimeByAddr_indexForKey(&addr, &admin->map);
         uint64_t now = Time_currentTimeMilliseconds();
         if (index < 0 || checkAddress(admin, index, now)) {
+            // this alloc is ours (no current request), don't leak it
+            Allocator_free(alloc);
             return Admin_sendMessage_CHANNEL_CLOSED;
         }
     }
@@ -391,10 +393,24 @@ static void handleRequest(Dict* messageDict,
 
     Dict* args = Dict_getDictC(messageDict, "args");
     bool noFunctionsCalled = true;
-    for (int i = 0; i < admin->functionCount; i++) {
-        if (String_equals(query, admin->functions[i].name)
-            && (authed || !admin->functions[i].needsAuth))
-        {
+
+    // The function table is kept sorted by name, find the first match by
+    // binary search and then walk the duplicates (multiple registrations of
+    // one name are all called, as always).
+    int lo = 0;
+    int hi = admin->functionCount;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (String_compare(admin->functions[mid].name, query) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    for (int i = lo; i < admin->functionCount
+        && String_equals(query, admin->functions[i].name); i++)
+    {
+        if (authed || !admin->functions[i].needsAuth) {
             if (checkArgs(args, &admin->functions[i], txid, Message_getAlloc(message), admin)) {
                 admin->functions[i].call(args, admin->functions[i].context, txid, Message_getAlloc(message));
             }
@@ -494,7 +510,16 @@ void Admin_registerFunctionWithArgCount(char* name,
         Allocator_realloc(admin->allocator,
                           admin->functions,
                           sizeof(struct Function) * (admin->functionCount + 1));
-    struct Function* fu = &admin->functions[admin->functionCount];
+
+    // keep the table sorted by name so dispatch can binary search
+    int pos = admin->functionCount;
+    while (pos > 0 && String_compare(admin->functions[pos - 1].name, str) > 0) {
+        pos--;
+    }
+    Bits_memmove(&admin->functions[pos + 1],
+                 &admin->functions[pos],
+                 sizeof(struct Function) * (admin->functionCount - pos));
+    struct Function* fu = &admin->functions[pos];
     admin->functionCount++;
 
     fu->name = str;
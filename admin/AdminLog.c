@@ -13,6 +13,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include <stdarg.h> // for String_vprintf()
+#include <stdio.h> // for vsnprintf()
 
 #include "admin/Admin.h"
 #include "admin/AdminLog.h"
@@ -25,6 +26,7 @@
 #include "util/log/Log.h"
 #include "util/log/Log_impl.h"
 #include "util/Hex.h"
+#include "util/CString.h"
 #include "util/Identity.h"
 #include "util/events/Time.h"
 #include "util/events/Timeout.h"
@@ -32,6 +34,20 @@
 #define MAX_SUBSCRIPTIONS 64
 #define FILE_NAME_COUNT 32
 
+/** Ring of recent log entries which can be drained over the admin socket. */
+#define RING_SIZE 128
+#define RING_MSG_MAX 220
+
+struct RingEntry
+{
+    uint64_t seq;
+    uint64_t timeMs;
+    enum Log_Level level;
+    const char* file;
+    int line;
+    char message[RING_MSG_MAX];
+};
+
 struct Subscription
 {
     /** The log level to match against, all higher levels will also be matched. */
@@ -77,6 +93,29 @@ struct AdminLog
     struct Allocator* alloc;
     struct Random* rand;
     struct EventBase* base;
+
+    /**
+     * Always-on ring of recent entries at ringLevel and above, drained in
+     * bulk with AdminLog_drain so recent history is readable after the fact
+     * without a streaming subscription.
+     */
+    struct RingEntry ring[RING_SIZE];
+    uint64_t ringSeq;
+    enum Log_Level ringLevel;
+
+    /**
+     * Runtime per-module floors: entries below the level set for their file
+     * are dropped before any formatting or subscriber work. Compile-time
+     * stripping still removes whole levels; this silences chatty modules in
+     * a running daemon.
+     */
+    #define FILE_LEVELS_MAX 16
+    struct {
+        char file[64];
+        enum Log_Level level;
+    } fileLevels[FILE_LEVELS_MAX];
+    int fileLevelCount;
+
     Identity
 };
 
@@ -185,8 +224,29 @@ static void doLog(struct Log* genericLog,
     struct Allocator* logLineAlloc = NULL;
 
     if (log->logging) { return; }
+
+    for (int i = 0; i < log->fileLevelCount; i++) {
+        if (CString_strstr(fullFilePath, log->fileLevels[i].file)) {
+            if (logLevel < log->fileLevels[i].level) { return; }
+            break;
+        }
+    }
+
     log->logging++;
 
+    if (logLevel >= log->ringLevel) {
+        struct RingEntry* e = &log->ring[log->ringSeq % RING_SIZE];
+        e->seq = ++log->ringSeq;
+        e->timeMs = Time_currentTimeMilliseconds();
+        e->level = logLevel;
+        e->file = fullFilePath;
+        e->line = line;
+        va_list ringArgs;
+        va_copy(ringArgs, args);
+        vsnprintf(e->message, RING_MSG_MAX, format, ringArgs);
+        va_end(ringArgs);
+    }
+
     for (int i = log->subscriptionCount - 1; i >= 0; i--) {
         if (!isMatch(&log->subscriptions[i], log, logLevel, fullFilePath, line)) { continue; }
         if (log->subscriptions[i].dropped) {
@@ -225,6 +285,85 @@ static void doLog(struct Log* genericLog,
     Assert_true(!--log->logging);
 }
 
+#define DRAIN_PAGE 32
+static void drain(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
+{
+    struct AdminLog* log = Identity_check((struct AdminLog*) vcontext);
+    int64_t* sinceP = Dict_getIntC(args, "since");
+    uint64_t since = (sinceP && *sinceP > 0) ? (uint64_t) *sinceP : 0;
+
+    // Entries older than the window are gone, start from the oldest retained.
+    uint64_t oldest = (log->ringSeq > RING_SIZE) ? log->ringSeq - RING_SIZE : 0;
+    if (since < oldest) { since = oldest; }
+
+    List* entries = List_new(requestAlloc);
+    int count = 0;
+    for (uint64_t seq = since + 1; seq <= log->ringSeq && count < DRAIN_PAGE; seq++) {
+        struct RingEntry* e = &log->ring[(seq - 1) % RING_SIZE];
+        if (e->seq != seq) { continue; }
+        Dict* d = Dict_new(requestAlloc);
+        Dict_putIntC(d, "seq", e->seq, requestAlloc);
+        Dict_putIntC(d, "time", e->timeMs, requestAlloc);
+        Dict_putStringCC(d, "level", Log_nameForLevel(e->level), requestAlloc);
+        Dict_putStringCC(d, "file", (char*) e->file, requestAlloc);
+        Dict_putIntC(d, "line", e->line, requestAlloc);
+        Dict_putStringC(d, "message", String_new(e->message, requestAlloc), requestAlloc);
+        List_addDict(entries, d, requestAlloc);
+        count++;
+    }
+
+    Dict* out = Dict_new(requestAlloc);
+    Dict_putListC(out, "entries", entries, requestAlloc);
+    Dict_putIntC(out, "lastSeq", log->ringSeq, requestAlloc);
+    Admin_sendMessage(out, txid, log->admin);
+}
+
+static void setRingLevel(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
+{
+    struct AdminLog* log = Identity_check((struct AdminLog*) vcontext);
+    String* levelName = Dict_getStringC(args, "level");
+    enum Log_Level level = (levelName) ? Log_levelForName(levelName->bytes) : Log_Level_INVALID;
+    Dict* out = Dict_new(requestAlloc);
+    if (level == Log_Level_INVALID) {
+        Dict_putStringCC(out, "error", "invalid log level", requestAlloc);
+    } else {
+        log->ringLevel = level;
+        Dict_putStringCC(out, "error", "none", requestAlloc);
+    }
+    Admin_sendMessage(out, txid, log->admin);
+}
+
+static void setFileLevel(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
+{
+    struct AdminLog* log = Identity_check((struct AdminLog*) vcontext);
+    String* fileStr = Dict_getStringC(args, "file");
+    String* levelName = Dict_getStringC(args, "level");
+    enum Log_Level level = (levelName) ? Log_levelForName(levelName->bytes) : Log_Level_INVALID;
+
+    char* error = NULL;
+    if (level == Log_Level_INVALID) {
+        error = "invalid log level";
+    } else if (!fileStr || !fileStr->len || fileStr->len >= 64) {
+        error = "file must be between 1 and 63 characters";
+    } else {
+        int i = 0;
+        for (; i < log->fileLevelCount; i++) {
+            if (!CString_strcmp(log->fileLevels[i].file, fileStr->bytes)) { break; }
+        }
+        if (i >= FILE_LEVELS_MAX) {
+            error = "too many file level rules";
+        } else {
+            CString_safeStrncpy(log->fileLevels[i].file, fileStr->bytes, 64);
+            log->fileLevels[i].level = level;
+            if (i == log->fileLevelCount) { log->fileLevelCount++; }
+        }
+    }
+
+    Dict* out = Dict_new(requestAlloc);
+    Dict_putStringCC(out, "error", (error) ? error : "none", requestAlloc);
+    Admin_sendMessage(out, txid, log->admin);
+}
+
 static void subscribe(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
 {
     struct AdminLog* log = Identity_check((struct AdminLog*) vcontext);
@@ -344,7 +483,8 @@ struct Log* AdminLog_registerNew(struct Admin* admin,
         .admin = admin,
         .alloc = alloc,
         .rand = rand,
-        .base = base
+        .base = base,
+        .ringLevel = Log_Level_INFO
     }));
     Identity_set(log);
 
@@ -362,6 +502,22 @@ struct Log* AdminLog_registerNew(struct Admin* admin,
 
     Admin_registerFunction("AdminLog_subscriptions", subscriptions, log, true, NULL, admin);
 
+    Admin_registerFunction("AdminLog_drain", drain, log, true,
+        ((struct Admin_FunctionArg[]) {
+            { .name = "since", .required = 0, .type = "Int" }
+        }), admin);
+
+    Admin_registerFunction("AdminLog_setRingLevel", setRingLevel, log, true,
+        ((struct Admin_FunctionArg[]) {
+            { .name = "level", .required = 1, .type = "String" }
+        }), admin);
+
+    Admin_registerFunction("AdminLog_setFileLevel", setFileLevel, log, true,
+        ((struct Admin_FunctionArg[]) {
+            { .name = "file", .required = 1, .type = "String" },
+            { .name = "level", .required = 1, .type = "String" }
+        }), admin);
+
     Admin_registerFunction("AdminLog_logMany", logMany, log, true,
         ((struct Admin_FunctionArg[]) {
             { .name = "count", .required = 1, .type = "Int" }
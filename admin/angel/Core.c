@@ -12,6 +12,11 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
+#if defined(linux) && !defined(_GNU_SOURCE)
+    // for sched_setaffinity()
+    #define _GNU_SOURCE
+#endif
+
 #include "admin/Admin.h"
 #include "admin/AdminLog.h"
 #include "admin/angel/Core.h"
@@ -24,6 +29,10 @@
 #include "crypto/random/Random.h"
 #include "crypto/random/nanotime/NanotimeEntropyProvider.h"
 #include "crypto/Sign_admin.h"
+#include "crypto/Crypto_admin.h"
+#include "util/Metrics.h"
+#include "util/Metrics_admin.h"
+#include "util/Watchdog.h"
 #include "subnode/SubnodePathfinder.h"
 #include "subnode/SupernodeHunter_admin.h"
 #include "subnode/ReachabilityCollector_admin.h"
@@ -54,6 +63,7 @@
 
 #define NumberCompress_OLD_CODE
 #include "switch/NumberCompress.h"
+#include "switch/SwitchCore_admin.h"
 
 #include "tunnel/IpTunnel_admin.h"
 #include "tunnel/RouteGen_admin.h"
@@ -61,6 +71,7 @@
 #include "util/events/Pipe.h"
 #include "util/events/PipeServer.h"
 #include "util/events/Timeout.h"
+#include "util/events/Time.h"
 #include "util/Hex.h"
 #include "util/log/FileWriterLog.h"
 #include "util/log/IndirectLog.h"
@@ -79,6 +90,10 @@
 
 #include <stdlib.h>
 #include <unistd.h>
+#if defined(linux)
+    #include <sched.h>
+    #include <sys/resource.h>
+#endif
 
 // Failsafe: abort if more than 2^23 bytes are allocated (8MB)
 #define ALLOCATOR_FAILSAFE (1<<23)
@@ -131,6 +146,95 @@ struct Context
     Identity
 };
 
+static uint64_t readLoopStalls(void* vBase)
+{
+    uint64_t stalls = 0;
+    EventBase_stallStats((struct EventBase*) vBase, &stalls, NULL, NULL);
+    return stalls;
+}
+
+static uint64_t readLoopMaxStallMs(void* vBase)
+{
+    uint64_t maxStallMs = 0;
+    EventBase_stallStats((struct EventBase*) vBase, NULL, &maxStallMs, NULL);
+    return maxStallMs;
+}
+
+static uint64_t readAllocatedBytes(void* vAlloc)
+{
+    return Allocator_bytesAllocated((struct Allocator*) vAlloc);
+}
+
+static void adminStallStats(Dict* input, void* vcontext, String* txid, struct Allocator* requestAlloc)
+{
+    struct Context* ctx = Identity_check((struct Context*) vcontext);
+    uint64_t stalls = 0;
+    uint64_t maxStallMs = 0;
+    uint64_t samples = 0;
+    EventBase_stallStats(ctx->base, &stalls, &maxStallMs, &samples);
+    Dict d = Dict_CONST(String_CONST("maxStallMs"), Int_OBJ(maxStallMs), Dict_CONST(
+                        String_CONST("samples"), Int_OBJ(samples), Dict_CONST(
+                        String_CONST("stalls"), Int_OBJ(stalls), NULL
+    )));
+    Admin_sendMessage(&d, txid, ctx->admin);
+}
+
+static void adminPathfinderStats(
+    Dict* input, void* vcontext, String* txid, struct Allocator* requestAlloc)
+{
+    struct Context* ctx = Identity_check((struct Context*) vcontext);
+    List* list = List_new(requestAlloc);
+    for (int i = 0;; i++) {
+        struct EventEmitter_PathfinderStats stats;
+        int ret = EventEmitter_getPathfinderStats(ctx->nc->ee, i, &stats);
+        if (ret < 0) { break; }
+        if (!ret) { continue; }
+        Dict* d = Dict_new(requestAlloc);
+        Dict_putIntC(d, "pathfinderId", stats.pathfinderId, requestAlloc);
+        Dict_putIntC(d, "superiority", stats.superiority, requestAlloc);
+        Dict_putIntC(d, "state", stats.state, requestAlloc);
+        Dict_putIntC(d, "eventsIn", stats.eventsIn, requestAlloc);
+        Dict_putIntC(d, "nodesIn", stats.nodesIn, requestAlloc);
+        Dict_putStringC(d, "userAgent",
+            String_new((char*) stats.userAgent, requestAlloc), requestAlloc);
+        List_addDict(list, d, requestAlloc);
+    }
+    Dict* out = Dict_new(requestAlloc);
+    Dict_putListC(out, "pathfinders", list, requestAlloc);
+    Admin_sendMessage(out, txid, ctx->admin);
+}
+
+#define TIMER_AUDIT_MAX 256
+static void adminTimerAudit(Dict* input, void* vcontext, String* txid, struct Allocator* requestAlloc)
+{
+    struct Context* ctx = Identity_check((struct Context*) vcontext);
+    struct Timeout_AuditInfo* infos =
+        Allocator_calloc(requestAlloc, sizeof(struct Timeout_AuditInfo), TIMER_AUDIT_MAX);
+    int num = Timeout_audit(ctx->base, infos, TIMER_AUDIT_MAX);
+
+    List* timers = List_new(requestAlloc);
+    uint64_t wakesPerMinute = 0;
+    for (int i = 0; i < num; i++) {
+        Dict* d = Dict_new(requestAlloc);
+        Dict_putStringCC(d, "setter",
+            String_printf(requestAlloc, "%s:%d", infos[i].file, infos[i].line)->bytes,
+            requestAlloc);
+        Dict_putIntC(d, "ms", infos[i].milliseconds, requestAlloc);
+        Dict_putIntC(d, "interval", infos[i].isInterval, requestAlloc);
+        Dict_putIntC(d, "armed", infos[i].isArmed, requestAlloc);
+        List_addDict(timers, d, requestAlloc);
+        if (infos[i].isInterval && infos[i].isArmed && infos[i].milliseconds) {
+            wakesPerMinute += 60000 / infos[i].milliseconds;
+        }
+    }
+
+    Dict* out = Dict_new(requestAlloc);
+    Dict_putListC(out, "timers", timers, requestAlloc);
+    Dict_putIntC(out, "count", num, requestAlloc);
+    Dict_putIntC(out, "intervalWakesPerMinute", wakesPerMinute, requestAlloc);
+    Admin_sendMessage(out, txid, ctx->admin);
+}
+
 static void shutdown(void* vcontext)
 {
     struct Context* context = Identity_check((struct Context*) vcontext);
@@ -338,12 +442,22 @@ void Core_init(struct Allocator* alloc,
                struct FakeNetwork* fakeNet,
                bool noSec)
 {
+    // Startup phase breakdown, logged at INFO so slow boots are explainable.
+    uint64_t phaseTime = Time_hrtime();
+    #define STARTUP_PHASE(name) \
+        do { \
+            uint64_t now = Time_hrtime(); \
+            Log_info(logger, "STARTUP %s [%d]ms", (name), (int)((now - phaseTime) / 1000000)); \
+            phaseTime = now; \
+        } while (0)
+
     struct Security* sec = NULL;
     if (!noSec) {
         sec = Security_new(alloc, logger, eventBase);
     }
     struct GlobalConfig* globalConf = GlobalConfig_new(alloc);
     struct NetCore* nc = NetCore_new(privateKey, alloc, eventBase, rand, logger, !Defined(NOISE_NO));
+    STARTUP_PHASE("core");
 
     struct RouteGen* rg = RouteGen_new(alloc, logger);
 
@@ -355,20 +469,26 @@ void Core_init(struct Allocator* alloc,
     struct EncodingScheme* encodingScheme = NumberCompress_defineScheme(alloc);
 
     // The link between the Pathfinder and the core needs to be asynchronous.
+    // The pathfinders draw randomness in bursts (search targets, query
+    // cookies); give each its own forked generator so that demand never
+    // drains the buffer shared with the security-sensitive users.
     struct SubnodePathfinder* spf = SubnodePathfinder_new(
-        alloc, logger, eventBase, rand, nc->myAddress, privateKey, encodingScheme);
+        alloc, logger, eventBase, Random_fork(rand, alloc),
+        nc->myAddress, privateKey, encodingScheme);
     struct ASynchronizer* spfAsync = ASynchronizer_new(alloc, eventBase, logger);
     Iface_plumb(&spfAsync->ifA, &spf->eventIf);
     EventEmitter_regPathfinderIface(nc->ee, &spfAsync->ifB);
 
     #ifndef SUBNODE
-        struct Pathfinder* opf = Pathfinder_register(alloc, logger, eventBase, rand, admin);
+        struct Pathfinder* opf =
+            Pathfinder_register(alloc, logger, eventBase, Random_fork(rand, alloc), admin);
         struct ASynchronizer* opfAsync = ASynchronizer_new(alloc, eventBase, logger);
         Iface_plumb(&opfAsync->ifA, &opf->eventIf);
         EventEmitter_regPathfinderIface(nc->ee, &opfAsync->ifB);
     #endif
 
     SubnodePathfinder_start(spf);
+    STARTUP_PHASE("pathfinders");
 
     // ------------------- Register RPC functions ----------------------- //
     UpperDistributor_admin_register(nc->upper, admin, alloc);
@@ -391,8 +511,77 @@ void Core_init(struct Allocator* alloc,
     }
     IpTunnel_admin_register(ipTunnel, admin, alloc);
     SessionManager_admin_register(nc->sm, admin, alloc);
+    SwitchCore_admin_register(nc->switchCore, admin, alloc);
     Allocator_admin_register(alloc, admin);
     Sign_admin_register(privateKey, admin, rand, alloc);
+    Crypto_admin_register(rand, admin, alloc);
+
+    // Scheduling knobs: CJDNS_AFFINITY=<cpu> pins the loop to one core (which
+    // also keeps its caches and, with it, the batching work effective) and
+    // CJDNS_NICE=<n> adjusts priority. Both opt-in.
+    #if defined(linux)
+    {
+        char* affinity = getenv("CJDNS_AFFINITY");
+        if (affinity) {
+            int cpu = atoi(affinity);
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            if (sched_setaffinity(0, sizeof(set), &set)) {
+                Log_warn(logger, "sched_setaffinity(%d) failed", cpu);
+            } else {
+                Log_info(logger, "Pinned to cpu [%d]", cpu);
+            }
+        }
+        char* nice = getenv("CJDNS_NICE");
+        if (nice) {
+            int pri = atoi(nice);
+            if (setpriority(PRIO_PROCESS, 0, pri)) {
+                Log_warn(logger, "setpriority(%d) failed", pri);
+            } else {
+                Log_info(logger, "Priority set to [%d]", pri);
+            }
+        }
+    }
+    #endif
+
+    // Opt-in busy polling: CJDNS_BUSY_POLL=<iterations> makes the event loop
+    // spin that many non-blocking passes after each wake before sleeping
+    // again, trading idle CPU for burst latency.
+    {
+        char* busyPoll = getenv("CJDNS_BUSY_POLL");
+        if (busyPoll) {
+            int iterations = atoi(busyPoll);
+            if (iterations > 0) {
+                EventBase_setBusyPoll(eventBase, iterations);
+                Log_info(logger, "Busy polling [%d] iterations per wake", iterations);
+            } else {
+                Log_warn(logger, "CJDNS_BUSY_POLL must be a positive iteration count, ignoring");
+            }
+        }
+    }
+
+    // Opt-in loop watchdog: CJDNS_WATCHDOG=<ms> aborts the daemon (for a
+    // restart plus core) if the loop wedges longer than the timeout.
+    {
+        char* watchdogMs = getenv("CJDNS_WATCHDOG");
+        if (watchdogMs) {
+            int64_t ms = strtol(watchdogMs, NULL, 10);
+            if (ms >= 1000) {
+                Watchdog_start((uint32_t) ms, eventBase, logger, alloc);
+            } else {
+                Log_warn(logger, "CJDNS_WATCHDOG must be at least 1000 (ms), ignoring");
+            }
+        }
+    }
+
+    struct Metrics* metrics = Metrics_new(alloc);
+    Metrics_registerGauge(metrics, "loopStalls", readLoopStalls, eventBase);
+    Metrics_registerGauge(metrics, "loopMaxStallMs", readLoopMaxStallMs, eventBase);
+    Metrics_registerGauge(metrics, "allocatedBytes", readAllocatedBytes, alloc);
+    Metrics_admin_register(metrics, admin, alloc);
+    STARTUP_PHASE("admin");
+    #undef STARTUP_PHASE
 
     struct Context* ctx = Allocator_calloc(alloc, sizeof(struct Context), 1);
     Identity_set(ctx);
@@ -409,6 +598,12 @@ void Core_init(struct Allocator* alloc,
 
     Admin_registerFunction("Core_pid", adminPid, admin, false, NULL, admin);
 
+    Admin_registerFunction("Core_stallStats", adminStallStats, ctx, false, NULL, admin);
+
+    Admin_registerFunction("Core_pathfinderStats", adminPathfinderStats, ctx, false, NULL, admin);
+
+    Admin_registerFunction("Core_timerAudit", adminTimerAudit, ctx, false, NULL, admin);
+
     Admin_registerFunction("Core_initTunnel", initTunnel, ctx, true,
         ((struct Admin_FunctionArg[]) {
             { .name = "desiredTunName", .required = 0, .type = "String" }
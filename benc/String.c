@@ -79,6 +79,60 @@ int String_compare(const String* a, const String* b)
     return a->len - b->len;
 }
 
+/**
+ * Shared read-only copies of the key strings which appear in virtually every
+ * wire and admin message, so parsing a dict does not allocate a fresh copy of
+ * "q" or "txid" per message. Only handed out for dict keys, which nothing
+ * mutates.
+ */
+#define INTERN(name, value) \
+    static char String_internBytes_##name[] = value; \
+    static String String_intern_##name = \
+        { .len = sizeof(value) - 1, .bytes = String_internBytes_##name };
+INTERN(q, "q")
+INTERN(txid, "txid")
+INTERN(args, "args")
+INTERN(aq, "aq")
+INTERN(error, "error")
+INTERN(cookie, "cookie")
+INTERN(hash, "hash")
+INTERN(p, "p")
+INTERN(es, "es")
+INTERN(ei, "ei")
+INTERN(tar, "tar")
+INTERN(n, "n")
+INTERN(np, "np")
+INTERN(snode, "snode")
+#undef INTERN
+
+static String* const String_internTable[] = {
+    &String_intern_q,
+    &String_intern_txid,
+    &String_intern_args,
+    &String_intern_aq,
+    &String_intern_error,
+    &String_intern_cookie,
+    &String_intern_hash,
+    &String_intern_p,
+    &String_intern_es,
+    &String_intern_ei,
+    &String_intern_tar,
+    &String_intern_n,
+    &String_intern_np,
+    &String_intern_snode,
+};
+
+String* String_getInterned(const char* bytes, uintptr_t len)
+{
+    for (uintptr_t i = 0; i < sizeof(String_internTable) / sizeof(*String_internTable); i++) {
+        String* s = String_internTable[i];
+        if (s->len == len && !Bits_memcmp(s->bytes, bytes, len)) {
+            return s;
+        }
+    }
+    return NULL;
+}
+
 int String_equals(const String* a, const String* b)
 {
     if (a == NULL || b == NULL) {
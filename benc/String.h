@@ -56,6 +56,13 @@ String* String_new(const char* bytes, struct Allocator* allocator);
  */
 String* String_newBinary(const char* bytes, uintptr_t length, struct Allocator* allocator);
 
+/**
+ * Get a shared read-only String for well-known protocol key content,
+ * or NULL if the content is not one of the interned keys. The returned
+ * String outlives every allocator and must never be mutated.
+ */
+String* String_getInterned(const char* bytes, uintptr_t length);
+
 #define String_clone(string, alloc) \
     ((string) ? String_newBinary(string->bytes, string->len, alloc) : NULL)
 
@@ -24,6 +24,9 @@
 
 static Er_DEFUN(Object* readGeneric(struct Message* msg, struct Allocator* alloc));
 
+/** Parse a value into caller-provided (zeroed) storage, see readGeneric(). */
+static Er_DEFUN(void readGenericInto(struct Message* msg, struct Allocator* alloc, Object* out));
+
 static Er_DEFUN(int64_t readInt(struct Message* msg, struct Allocator* alloc))
 {
     int64_t num = Er(Base10_read(msg));
@@ -50,6 +53,33 @@ static Er_DEFUN(String* readString(struct Message* msg, struct Allocator* alloc)
     Er_ret(str);
 }
 
+/**
+ * Like readString() but for dict keys: the handful of well-known keys which
+ * appear in every message come back as shared interned strings with no
+ * allocation.
+ */
+static Er_DEFUN(String* readKeyString(struct Message* msg, struct Allocator* alloc))
+{
+    int64_t len = Er(Base10_read(msg));
+    if (len < 0) {
+        Er_raise(alloc, "Negative string length");
+    }
+    if (Er(Message_epop8(msg)) != ':') {
+        Er_raise(alloc, "String not deliniated with a ':'");
+    }
+    if (len > Message_getLength(msg)) {
+        Er_raise(alloc, "String too long");
+    }
+    String* interned = String_getInterned((const char*) msg->msgbytes, len);
+    if (interned) {
+        Er(Message_epop(msg, NULL, len));
+        Er_ret(interned);
+    }
+    String* str = String_newBinary(NULL, len, alloc);
+    Er(Message_epop(msg, str->bytes, len));
+    Er_ret(str);
+}
+
 static Er_DEFUN(List* readList(struct Message* msg, struct Allocator* alloc))
 {
     struct List_Item* last = NULL;
@@ -62,8 +92,11 @@ static Er_DEFUN(List* readList(struct Message* msg, struct Allocator* alloc))
         }
         Er(Message_epush8(msg, chr));
 
-        struct List_Item* item = Allocator_malloc(alloc, sizeof(struct List_Item));
-        item->elem = Er(readGeneric(msg, alloc));
+        // item and its value object come out of one zeroed allocation
+        struct List_Item* item =
+            Allocator_calloc(alloc, sizeof(struct List_Item) + sizeof(Object), 1);
+        item->elem = (Object*) &item[1];
+        Er(readGenericInto(msg, alloc, item->elem));
         item->next = last;
         last = item;
     }
@@ -81,9 +114,12 @@ static Er_DEFUN(Dict* readDict(struct Message* msg, struct Allocator* alloc))
         }
         Er(Message_epush8(msg, chr));
 
-        struct Dict_Entry* entry = Allocator_malloc(alloc, sizeof(struct Dict_Entry));
-        entry->key = Er(readString(msg, alloc));
-        entry->val = Er(readGeneric(msg, alloc));
+        // entry and its value object come out of one zeroed allocation
+        struct Dict_Entry* entry =
+            Allocator_calloc(alloc, sizeof(struct Dict_Entry) + sizeof(Object), 1);
+        entry->key = Er(readKeyString(msg, alloc));
+        entry->val = (Object*) &entry[1];
+        Er(readGenericInto(msg, alloc, entry->val));
         entry->next = last;
         last = entry;
     }
@@ -91,8 +127,14 @@ static Er_DEFUN(Dict* readDict(struct Message* msg, struct Allocator* alloc))
 
 static Er_DEFUN(Object* readGeneric(struct Message* msg, struct Allocator* alloc))
 {
-    uint8_t chr = Er(Message_epop8(msg));
     Object* out = Allocator_calloc(alloc, sizeof(Object), 1);
+    Er(readGenericInto(msg, alloc, out));
+    Er_ret(out);
+}
+
+static Er_DEFUN(void readGenericInto(struct Message* msg, struct Allocator* alloc, Object* out))
+{
+    uint8_t chr = Er(Message_epop8(msg));
     switch (chr) {
         case 'l': {
             out->type = Object_LIST;
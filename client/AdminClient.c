@@ -21,6 +21,7 @@
 #include "util/Endian.h"
 #include "util/Hex.h"
 #include "util/events/Timeout.h"
+#include "util/events/Time.h"
 #include "util/Identity.h"
 #include "wire/Message.h"
 #include "wire/Error.h"
@@ -69,6 +70,16 @@ struct Context
     String* password;
     struct Map_OfRequestByHandle outstandingRequests;
     struct Allocator* alloc;
+
+    /**
+     * The most recent cookie from the admin server. Cookies stay valid for 20
+     * seconds server-side; reusing one for 10 halves the round trips of every
+     * call made in that window.
+     */
+    struct Allocator* cookieAlloc;
+    String* cachedCookie;
+    uint64_t cookieTimeSecs;
+
     Identity
 };
 
@@ -241,6 +252,13 @@ static void cookieCallback(struct Request* req)
         return;
     }
 
+    // remember it for the next calls in the validity window
+    struct Context* ctx = req->ctx;
+    if (ctx->cookieAlloc) { Allocator_free(ctx->cookieAlloc); }
+    ctx->cookieAlloc = Allocator_child(ctx->alloc);
+    ctx->cachedCookie = String_clone(cookie, ctx->cookieAlloc);
+    ctx->cookieTimeSecs = Time_currentTimeSeconds();
+
     Dict* message = req->requestMessage;
     sendRaw(message, req->promise, req->ctx, cookie, requestCallback);
     Allocator_free(req->alloc);
@@ -255,6 +273,15 @@ static struct AdminClient_Promise* doCall(Dict* message,
         Allocator_calloc(promiseAlloc, sizeof(struct AdminClient_Promise), 1);
     promise->alloc = promiseAlloc;
 
+    if (ctx->cachedCookie
+        && Time_currentTimeSeconds() - ctx->cookieTimeSecs < 10)
+    {
+        // cookie still fresh, skip the extra round trip
+        Dict* msgCopy = Cloner_cloneDict(message, promiseAlloc);
+        sendRaw(msgCopy, promise, ctx, ctx->cachedCookie, requestCallback);
+        return promise;
+    }
+
     Dict gc = Dict_CONST(String_CONST("q"), String_OBJ(String_CONST("cookie")), NULL);
     struct Request* req = sendRaw(&gc, promise, ctx, NULL, cookieCallback);
 
@@ -127,6 +127,73 @@ static void rpcCall(String* function, Dict* args, struct Context* ctx, struct Al
     rpcCall0(function, args, ctx, alloc, NULL, true);
 }
 
+/** Bookkeeping for one call within a pipelined batch, see batchRpcCallback(). */
+struct BatchCall
+{
+    struct Context* ctx;
+    String* function;
+    int* outstanding;
+    int* failures;
+};
+
+static void batchRpcCallback(struct AdminClient_Promise* p, struct AdminClient_Result* res)
+{
+    struct BatchCall* bc = p->userData;
+    struct Context* ctx = bc->ctx;
+    Allocator_adopt(ctx->alloc, p->alloc);
+
+    if (res->err) {
+        Log_critical(ctx->logger,
+                     "Failed to make function call [%s], error: [%s]",
+                     AdminClient_errorString(res->err),
+                     bc->function->bytes);
+        (*bc->failures)++;
+    } else {
+        String* error = Dict_getStringC(res->responseDict, "error");
+        if (error && !String_equals(error, String_CONST("none"))) {
+            Log_critical(ctx->logger,
+                         "Got error [%s] calling [%s]",
+                         error->bytes,
+                         bc->function->bytes);
+            (*bc->failures)++;
+        }
+    }
+
+    if (!--(*bc->outstanding)) {
+        EventBase_endLoop(ctx->base);
+    }
+}
+
+/** Fire one call of a pipelined batch; wait with batchRpcWait() after the last one. */
+static void batchRpcCall(String* function,
+                         Dict* args,
+                         struct Context* ctx,
+                         struct Allocator* alloc,
+                         int* outstanding,
+                         int* failures)
+{
+    struct AdminClient_Promise* promise = AdminClient_rpcCall(function, args, ctx->client, alloc);
+    struct BatchCall* bc = Allocator_calloc(alloc, sizeof(struct BatchCall), 1);
+    bc->ctx = ctx;
+    bc->function = String_clone(function, alloc);
+    bc->outstanding = outstanding;
+    bc->failures = failures;
+    promise->callback = batchRpcCallback;
+    promise->userData = bc;
+    (*outstanding)++;
+}
+
+static void batchRpcWait(struct Context* ctx, int* outstanding, int* failures)
+{
+    if (*outstanding) {
+        EventBase_beginLoop(ctx->base);
+    }
+    if (*failures) {
+        Log_critical(ctx->logger, "[%d] calls of the batch failed. Aborting.", *failures);
+        exit(-1);
+    }
+}
+
 static void authorizedPasswords(List* list, struct Context* ctx)
 {
     uint32_t count = List_size(list);
@@ -144,35 +211,41 @@ static void authorizedPasswords(List* list, struct Context* ctx)
         }
     }
 
+    // The adds are independent, pipeline the whole list in one loop run
+    // instead of a round trip per password.
+    struct Allocator* batchAlloc = Allocator_child(ctx->alloc);
+    int outstanding = 0;
+    int failures = 0;
     for (uint32_t i = 0; i < count; i++) {
-        struct Allocator* child = Allocator_child(ctx->alloc);
         Dict* d = List_getDict(list, i);
         String* passwd = Dict_getStringC(d, "password");
         String* user = Dict_getStringC(d, "user");
         String* displayName = user;
         if (!displayName) {
-            displayName = String_printf(child, "password [%d]", i);
+            displayName = String_printf(batchAlloc, "password [%d]", i);
         }
         //String* publicKey = Dict_getStringC(d, "publicKey");
         String* ipv6 = Dict_getStringC(d, "ipv6");
         Log_info(ctx->logger, "Adding authorized password #[%d] for user [%s].",
             i, displayName->bytes);
-        Dict *args = Dict_new(child);
-        uint32_t i = 1;
-        Dict_putIntC(args, "authType", i, child);
-        Dict_putStringC(args, "password", passwd, child);
+        Dict *args = Dict_new(batchAlloc);
+        uint32_t authType = 1;
+        Dict_putIntC(args, "authType", authType, batchAlloc);
+        Dict_putStringC(args, "password", passwd, batchAlloc);
         if (user) {
-            Dict_putStringC(args, "user", user, child);
+            Dict_putStringC(args, "user", user, batchAlloc);
         }
-        Dict_putStringC(args, "displayName", displayName, child);
+        Dict_putStringC(args, "displayName", displayName, batchAlloc);
         if (ipv6) {
             Log_info(ctx->logger,
                 "  This connection password restricted to [%s] only.", ipv6->bytes);
-            Dict_putStringC(args, "ipv6", ipv6, child);
+            Dict_putStringC(args, "ipv6", ipv6, batchAlloc);
         }
-        rpcCall(String_CONST("AuthorizedPasswords_add"), args, ctx, child);
-        Allocator_free(child);
+        batchRpcCall(String_CONST("AuthorizedPasswords_add"), args, ctx, batchAlloc,
+                     &outstanding, &failures);
     }
+    batchRpcWait(ctx, &outstanding, &failures);
+    Allocator_free(batchAlloc);
 }
 
 static void udpInterfaceSetBeacon(
@@ -41,6 +41,8 @@
 
 #include <sodium/crypto_scalarmult_curve25519.h>
 
+#include <stdlib.h> // getenv()
+#include <stdio.h> // sscanf()
 #include <unistd.h> // isatty()
 
 struct NodeContext {
@@ -390,6 +392,24 @@ static void letErRip(Dict* config, struct Allocator* alloc)
 
     struct FakeNetwork* fakeNet = FakeNetwork_new(base, alloc, logger);
 
+    // SYBILSIM_CONDITIONS="latencyMs,jitterMs,lossPercent" degrades the
+    // simulated network for the whole run.
+    {
+        char* conditions = getenv("SYBILSIM_CONDITIONS");
+        if (conditions) {
+            unsigned latencyMs = 0;
+            unsigned jitterMs = 0;
+            unsigned lossPercent = 0;
+            if (sscanf(conditions, "%u,%u,%u", &latencyMs, &jitterMs, &lossPercent) == 3) {
+                FakeNetwork_setConditions(fakeNet, latencyMs, jitterMs, lossPercent);
+                Log_info(logger, "Simulating latency [%u]ms jitter [%u]ms loss [%u]%%",
+                         latencyMs, jitterMs, lossPercent);
+            } else {
+                Log_warn(logger, "Unparsable SYBILSIM_CONDITIONS, expected lat,jit,loss");
+            }
+        }
+    }
+
     String* key = NULL;
     Dict_forEach(ctx->confNodes, key) {
         Dict* val = Dict_getDict(ctx->confNodes, key);
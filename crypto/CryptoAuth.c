@@ -148,27 +148,37 @@ static inline void hashPassword(uint8_t secretOut[32],
  * @param context the CryptoAuth engine to search in.
  * @return an Auth struct with a if one is found, otherwise NULL.
  */
+/** Constant-time equality, the loop always covers every byte. */
+static inline uint8_t ctIsEqual(const uint8_t* a, const uint8_t* b, int len)
+{
+    uint8_t diff = 0;
+    for (int i = 0; i < len; i++) {
+        diff |= a[i] ^ b[i];
+    }
+    return !diff;
+}
+
 static inline struct CryptoAuth_User* getAuth(struct CryptoHeader_Challenge* auth,
                                               struct CryptoAuth_pvt* ca)
 {
-    if (auth->type == 0) {
+    if (auth->type != 1 && auth->type != 2) {
         return NULL;
     }
+    // Scan the whole list with full-width compares so the timing depends only
+    // on the number of registered credentials, never on which one matched or
+    // how close a guess came.
+    struct CryptoAuth_User* found = NULL;
     int count = 0;
     for (struct CryptoAuth_User* u = ca->users; u; u = u->next) {
         count++;
-        if (auth->type == 1 &&
-            !Bits_memcmp(auth, u->passwordHash, CryptoHeader_Challenge_KEYSIZE))
-        {
-            return u;
-        } else if (auth->type == 2 &&
-            !Bits_memcmp(auth, u->userNameHash, CryptoHeader_Challenge_KEYSIZE))
-        {
-            return u;
-        }
+        const uint8_t* hash = (auth->type == 1) ? u->passwordHash : u->userNameHash;
+        uint8_t eq = ctIsEqual((const uint8_t*) auth, hash, CryptoHeader_Challenge_KEYSIZE);
+        found = (eq && !found) ? u : found;
     }
-    Log_debug(ca->logger, "Got unrecognized auth, password count = [%d]", count);
-    return NULL;
+    if (!found) {
+        Log_debug(ca->logger, "Got unrecognized auth, password count = [%d]", count);
+    }
+    return found;
 }
 
 /**
@@ -275,6 +285,37 @@ static inline void encrypt(uint32_t nonce,
     encryptRndNonce(nonceAs.bytes, msg, secret);
 }
 
+/**
+ * getSharedSecret() for the permanent-private-key/herPublicKey pair, memoized
+ * on the session so repeat hello traffic does not pay the scalarmult again.
+ *
+ * Scope note: this engine only carries traffic when built with OLD_CA (and in
+ * the cross-implementation tests); production sessions run the Rust
+ * CryptoAuth2 behind crypto/Ca.h, which has its own handshake economics.
+ */
+static void getStaticSharedSecret(struct CryptoAuth_Session_pvt* session,
+                                  uint8_t* passwordHash,
+                                  uint8_t outputSecret[32])
+{
+    uint8_t key[64] = { 0 };
+    Bits_memcpy(key, session->herPublicKey, 32);
+    if (passwordHash) {
+        Bits_memcpy(&key[32], passwordHash, 32);
+    }
+    if (session->staticSecretSet && !Bits_memcmp(key, session->staticSecretKey, 64)) {
+        Bits_memcpy(outputSecret, session->staticSecret, 32);
+        return;
+    }
+    getSharedSecret(outputSecret,
+                    session->context->privateKey,
+                    session->herPublicKey,
+                    passwordHash,
+                    session->context->logger);
+    Bits_memcpy(session->staticSecretKey, key, 64);
+    Bits_memcpy(session->staticSecret, outputSecret, 32);
+    session->staticSecretSet = true;
+}
+
 static inline bool knowHerKey(struct CryptoAuth_Session_pvt* session)
 {
     return !Bits_isZero(session->herPublicKey, 32);
@@ -412,11 +453,7 @@ static void encryptHandshake(struct Message* message,
 
     uint8_t sharedSecret[32];
     if (session->nextNonce < CryptoAuth_State_RECEIVED_HELLO) {
-        getSharedSecret(sharedSecret,
-                        session->context->privateKey,
-                        session->herPublicKey,
-                        passwordHash,
-                        session->context->logger);
+        getStaticSharedSecret(session, passwordHash, sharedSecret);
 
         session->isInitiator = true;
 
@@ -528,6 +565,38 @@ int CryptoAuth_encrypt(struct CryptoAuth_Session* sessionPub, struct Message* ms
     return encryptPacket(session, msg);
 }
 
+int CryptoAuth_encryptVec(struct CryptoAuth_Session* sessionPub,
+                          struct Message** msgs,
+                          uint32_t count)
+{
+    struct CryptoAuth_Session_pvt* session =
+            Identity_check((struct CryptoAuth_Session_pvt*) sessionPub);
+
+    // The timeout check is per batch, the whole vector goes out in one instant.
+    resetIfTimeout(session);
+
+    for (uint32_t i = 0; i < count; i++) {
+        struct Message* msg = msgs[i];
+        if (session->nextNonce <= CryptoAuth_State_RECEIVED_KEY
+            || session->nextNonce >= 0xfffffff0)
+        {
+            // handshake states and nonce wrap are rare, take the one-message path
+            if (encryptPacket(session, msg)) { return -1; }
+            continue;
+        }
+
+        Assert_true(!((uintptr_t)msg->msgbytes % 4) || !"alignment fault");
+        Assert_true(Message_getLength(msg) > 0 && "Empty packet during handshake");
+        Assert_true(Message_getPadding(msg) >= 36 || !"not enough padding");
+
+        encrypt(session->nextNonce, msg, session->sharedSecret, session->isInitiator);
+
+        Er_assert(Message_epush32be(msg, session->nextNonce));
+        session->nextNonce++;
+    }
+    return 0;
+}
+
 /** Call the external interface and tell it that a message has been received. */
 static inline void updateTime(struct CryptoAuth_Session_pvt* session, struct Message* message)
 {
@@ -558,11 +627,41 @@ static bool ip6MatchesKey(uint8_t ip6[16], uint8_t key[32])
     return !Bits_memcmp(ip6, calculatedIp6, 16);
 }
 
+/**
+ * Handshakes allowed to burst before the flood limiter bites, refills 1/ms.
+ * The production (Rust CryptoAuth2) engine carries the same limiter in
+ * rust/cjdns_sys/src/crypto/crypto_auth.rs; keep the two in step.
+ */
+#define HANDSHAKE_BUCKET_SIZE 256
+
+static bool handshakeOverload(struct CryptoAuth_pvt* context)
+{
+    const uint64_t nowMs = Time_currentTimeMilliseconds();
+    uint64_t refill = nowMs - context->handshakeTokensTimeMs;
+    if (refill > HANDSHAKE_BUCKET_SIZE) { refill = HANDSHAKE_BUCKET_SIZE; }
+    context->handshakeTokens += refill;
+    if (context->handshakeTokens > HANDSHAKE_BUCKET_SIZE) {
+        context->handshakeTokens = HANDSHAKE_BUCKET_SIZE;
+    }
+    context->handshakeTokensTimeMs = nowMs;
+    if (!context->handshakeTokens) { return true; }
+    context->handshakeTokens--;
+    return false;
+}
+
 static enum CryptoAuth_DecryptErr decryptHandshake(struct CryptoAuth_Session_pvt* session,
                                                    const uint32_t nonce,
                                                    struct Message* message,
                                                    struct CryptoHeader* header)
 {
+    if (handshakeOverload(session->context)) {
+        // A wireguard-style stateless cookie challenge would be the complete
+        // answer but needs a wire extension; dropping under flood keeps the
+        // loop alive and legitimate peers simply retry.
+        cryptoAuthDebug0(session, "DROP handshake, overloaded");
+        return CryptoAuth_DecryptErr_NO_SESSION;
+    }
+
     if (Message_getLength(message) < CryptoHeader_SIZE) {
         cryptoAuthDebug0(session, "DROP runt");
         return CryptoAuth_DecryptErr_RUNT;
@@ -616,11 +715,7 @@ static enum CryptoAuth_DecryptErr decryptHandshake(struct CryptoAuth_Session_pvt
             (nonce == Nonce_REPEAT_HELLO) ? "repeat " : "",
             (userObj != NULL));
 
-        getSharedSecret(sharedSecret,
-                        session->context->privateKey,
-                        session->herPublicKey,
-                        passwordHash,
-                        session->context->logger);
+        getStaticSharedSecret(session, passwordHash, sharedSecret);
         nextNonce = CryptoAuth_State_RECEIVED_HELLO;
     } else {
         if (nonce == Nonce_KEY) {
@@ -872,7 +967,9 @@ static enum CryptoAuth_DecryptErr decryptPacket(struct CryptoAuth_Session_pvt* s
 
             // This prevents a few "ghost" dropped packets at the beginning of a session.
             session->replayProtector.baseOffset = nonce + 1;
-            session->replayProtector.bitfield = 0;
+            Bits_memset(session->replayProtector.bitfield,
+                        0,
+                        sizeof(session->replayProtector.bitfield));
 
             if (!ret) {
                 cryptoAuthDebug0(session, "Final handshake step succeeded");
@@ -1217,7 +1314,7 @@ void CryptoAuth_stats(const struct CryptoAuth_Session* session, RTypes_CryptoSta
     const struct CryptoAuth_Session_pvt* s =
         Identity_check((struct CryptoAuth_Session_pvt*)session);
     statsOut->received_packets = s->replayProtector.baseOffset +
-        Bits_popCountx64(s->replayProtector.bitfield);
+        ReplayProtector_popCountLow(s->replayProtector.bitfield, ReplayProtector_WINDOW);
     statsOut->lost_packets = s->replayProtector.lostPackets;
     statsOut->received_unexpected = s->replayProtector.receivedOutOfRange;
     statsOut->duplicate_packets = s->replayProtector.duplicates;
@@ -135,6 +135,18 @@ struct CryptoAuth_Session* CryptoAuth_newSession(struct CryptoAuth* ca,
 /** @return 0 on success, -1 otherwise. */ // Now only used in unit tests on Rust side
 int CryptoAuth_encrypt(struct CryptoAuth_Session* session, struct Message* msg);
 
+/**
+ * Encrypt a vector of messages under one session in a single pass.
+ * The session timeout check runs once for the batch and the steady-state
+ * (post handshake) case keeps the session state hot across messages;
+ * handshake-state messages fall back to the one-message path.
+ *
+ * @return 0 on success, -1 otherwise.
+ */
+int CryptoAuth_encryptVec(struct CryptoAuth_Session* session,
+                          struct Message** msgs,
+                          uint32_t count);
+
 enum CryptoAuth_DecryptErr {
     CryptoAuth_DecryptErr_NONE = 0,
 
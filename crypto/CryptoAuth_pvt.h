@@ -63,6 +63,15 @@ struct CryptoAuth_pvt
     struct Allocator* allocator;
     struct Random* rand;
 
+    /**
+     * Token bucket limiting how many handshakes (expensive public-key work)
+     * are processed per unit time across all sessions, so a handshake flood
+     * degrades into dropped hellos instead of a pegged core. Established
+     * traffic is unaffected.
+     */
+    uint32_t handshakeTokens;
+    uint64_t handshakeTokensTimeMs;
+
     Identity
 };
 
@@ -71,17 +80,34 @@ struct CryptoAuth_Session_pvt
 {
     struct CryptoAuth_Session pub;
 
-    uint8_t herPublicKey[32];
+    // ---- hot: touched for every data packet, keep these on the leading cache lines ----
+    // (per-packet for OLD_CA builds and the unit tests; production sessions
+    // run the Rust CryptoAuth2 which has its own layout)
 
-    String* displayName;
+    /** The next nonce to use. */
+    uint32_t nextNonce;
+
+    /** Used to reset the connection if it's in a bad state (no traffic coming in). */
+    uint32_t timeOfLastPacket;
+
+    /** The shared secret. */
+    uint8_t sharedSecret[32];
 
     struct ReplayProtector replayProtector;
 
-    /**
-     * Bind this CryptoAuth session to the other node's ip6 address,
-     * any packet avertizing a key which doesn't hash to this will be dropped.
-     */
-    uint8_t herIp6[16];
+    /** The method to use for trying to auth with the server. */
+    int authType : 8;
+
+    /** True if this node began the conversation. */
+    bool isInitiator : 1;
+
+    /** If true and the other end is connecting, do not respond until a valid password is sent. */
+    bool requireAuth : 1;
+
+    bool established : 1;
+
+    /** A pointer back to the main cryptoauth context. */
+    struct CryptoAuth_pvt* context;
 
     /**
      * After this number of seconds of inactivity,
@@ -92,10 +118,28 @@ struct CryptoAuth_Session_pvt
     /** If a session is not completely setup, reset it after this many seconds of inactivity. */
     uint32_t setupResetAfterInactivitySeconds;
 
+    // ---- cold: handshake and identity state, only touched during session setup ----
+
+    uint8_t herPublicKey[32];
+
+    String* displayName;
+
+    /**
+     * Bind this CryptoAuth session to the other node's ip6 address,
+     * any packet avertizing a key which doesn't hash to this will be dropped.
+     */
+    uint8_t herIp6[16];
+
     struct Allocator* alloc;
 
-    /** The shared secret. */
-    uint8_t sharedSecret[32];
+    /**
+     * Memoized secret for the permanent-key derivation used on every hello
+     * packet, keyed by herPublicKey plus the password hash it was derived
+     * with. Saves a curve25519 scalarmult per handshake packet on the loop.
+     */
+    uint8_t staticSecret[32];
+    uint8_t staticSecretKey[64];
+    bool staticSecretSet;
 
     uint8_t herTempPubKey[32];
 
@@ -111,26 +155,6 @@ struct CryptoAuth_Session_pvt
     struct Allocator* loginAlloc;
     String* login;
 
-    /** The next nonce to use. */
-    uint32_t nextNonce;
-
-    /** Used to reset the connection if it's in a bad state (no traffic coming in). */
-    uint32_t timeOfLastPacket;
-
-    /** The method to use for trying to auth with the server. */
-    int authType : 8;
-
-    /** True if this node began the conversation. */
-    bool isInitiator : 1;
-
-    /** If true and the other end is connecting, do not respond until a valid password is sent. */
-    bool requireAuth : 1;
-
-    bool established : 1;
-
-    /** A pointer back to the main cryptoauth context. */
-    struct CryptoAuth_pvt* context;
-
     Identity
 };
 
@@ -0,0 +1,134 @@
+/* vim: set expandtab ts=4 sw=4: */
+/*
+ * You may redistribute this program and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "admin/Admin.h"
+#include "benc/Int.h"
+#include "benc/Dict.h"
+#include "crypto/AddressCalc.h"
+#include "crypto/Sign.h"
+#include "crypto/Crypto_admin.h"
+#include "crypto/random/Random.h"
+#include "util/ArchInfo.h"
+#include "util/events/Time.h"
+#include "util/Cycles.h"
+#include "util/Identity.h"
+#include "wire/Message.h"
+
+struct Context
+{
+    struct Allocator* alloc;
+    struct Random* rand;
+    struct Admin* admin;
+    Identity
+};
+
+/** Upper bound on iterations so one RPC cannot stall the event loop for long. */
+#define MAX_OPS 10000
+#define DEFAULT_OPS 1000
+
+static int64_t nsPerOp(uint64_t t0, uint64_t t1, int64_t ops)
+{
+    return (int64_t) ((t1 - t0) / (ops ? ops : 1));
+}
+
+static void bench(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
+{
+    struct Context* ctx = Identity_check((struct Context*) vcontext);
+
+    int64_t* opsP = Dict_getIntC(args, "ops");
+    int64_t ops = (opsP) ? *opsP : DEFAULT_OPS;
+    if (ops < 1) { ops = 1; }
+    if (ops > MAX_OPS) { ops = MAX_OPS; }
+
+    Dict* out = Dict_new(requestAlloc);
+
+    // salsa20 stream (Random_bytes large-request path)
+    {
+        uint8_t buff[1024];
+        uint64_t t0 = Time_hrtime();
+        for (int64_t i = 0; i < ops; i++) {
+            Random_bytes(ctx->rand, buff, sizeof(buff));
+        }
+        uint64_t t1 = Time_hrtime();
+        Dict_putIntC(out, "salsa20kbNs", nsPerOp(t0, t1, ops), requestAlloc);
+    }
+
+    // double sha512 address derivation
+    {
+        uint8_t key[32] = { 9 };
+        uint8_t addr[16];
+        uint64_t t0 = Time_hrtime();
+        for (int64_t i = 0; i < ops; i++) {
+            key[0] = (uint8_t) i;
+            AddressCalc_addressForPublicKey(addr, key);
+        }
+        uint64_t t1 = Time_hrtime();
+        Dict_putIntC(out, "addressCalcNs", nsPerOp(t0, t1, ops), requestAlloc);
+    }
+
+    // ed25519 sign + verify round trip
+    {
+        uint8_t secret[32];
+        uint8_t keyPair[64];
+        uint8_t pubKey[32];
+        Random_bytes(ctx->rand, secret, 32);
+        Sign_signingKeyPairFromCurve25519(keyPair, secret);
+        Sign_publicKeyFromKeyPair(pubKey, keyPair);
+        struct Message* msg = Message_new(0, 512, requestAlloc);
+        uint64_t t0 = Time_hrtime();
+        for (int64_t i = 0; i < ops; i++) {
+            Er_assert(Message_epush32h(msg, (uint32_t) i));
+            Sign_signMsg(keyPair, msg, ctx->rand);
+            Assert_true(!Sign_verifyMsg(pubKey, msg));
+            Er_assert(Message_epop32h(msg));
+        }
+        uint64_t t1 = Time_hrtime();
+        Dict_putIntC(out, "signVerifyNs", nsPerOp(t0, t1, ops), requestAlloc);
+    }
+
+    // rough tick rate so callers can convert the ns numbers into cycles
+    {
+        uint64_t c0 = Cycles_now();
+        uint64_t t0 = Time_hrtime();
+        uint8_t sink[256] = { 0 };
+        for (int i = 0; i < 64; i++) {
+            Random_bytes(ctx->rand, sink, sizeof(sink));
+        }
+        uint64_t t1 = Time_hrtime();
+        uint64_t c1 = Cycles_now();
+        if (t1 > t0) {
+            Dict_putIntC(out, "ticksPerUs", (c1 - c0) * 1000 / (t1 - t0), requestAlloc);
+        }
+    }
+
+    Dict_putIntC(out, "ops", ops, requestAlloc);
+    Dict_putIntC(out, "cpuFeatures", ArchInfo_getFeatures(), requestAlloc);
+    Dict_putStringCC(out, "error", "none", requestAlloc);
+    Admin_sendMessage(out, txid, ctx->admin);
+}
+
+void Crypto_admin_register(struct Random* rand, struct Admin* admin, struct Allocator* alloc)
+{
+    struct Context* ctx = Allocator_clone(alloc, (&(struct Context) {
+        .alloc = alloc,
+        .rand = rand,
+        .admin = admin
+    }));
+    Identity_set(ctx);
+
+    Admin_registerFunction("Crypto_bench", bench, ctx, true,
+        ((struct Admin_FunctionArg[]) {
+            { .name = "ops", .required = 0, .type = "Int" }
+        }), admin);
+}
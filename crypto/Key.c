@@ -27,13 +27,23 @@ int Key_gen(uint8_t addressOut[16],
             uint8_t privateKeyOut[32],
             struct Random* rand)
 {
+    Random_bytes(rand, privateKeyOut, 32);
     for (;;) {
-        Random_bytes(rand, privateKeyOut, 32);
         crypto_scalarmult_curve25519_base(publicKeyOut, privateKeyOut);
         // Brute force for keys until one matches FC00:/8
         if (AddressCalc_addressForPublicKey(addressOut, publicKeyOut)) {
             return 0;
         }
+        // Step the scalar by 8 rather than drawing fresh randomness: the
+        // clamp inside the scalarmult zeroes the low 3 bits, so any smaller
+        // step would just retry the same clamped scalar. Every clamped
+        // scalar is an equally good key, so the search loop is pure
+        // scalarmult + hash.
+        privateKeyOut[0] += 8;
+        if (privateKeyOut[0] < 8) {
+            // little-endian carry
+            for (int i = 1; i < 32 && !++privateKeyOut[i]; i++) { }
+        }
     }
 }
 
@@ -19,10 +19,14 @@
 
 #include <stdbool.h>
 
+/** Width of the anti-replay window in 64 bit words. */
+#define ReplayProtector_WORDS 4
+#define ReplayProtector_WINDOW (ReplayProtector_WORDS * 64)
+
 struct ReplayProtector
 {
-    /** internal bitfield. */
-    uint64_t bitfield;
+    /** internal bitfield, word zero holds the lowest offsets. */
+    uint64_t bitfield[ReplayProtector_WORDS];
 
     /** Internal offset. */
     uint32_t baseOffset;
@@ -42,15 +46,45 @@ struct ReplayProtector
     uint32_t receivedOutOfRange;
 };
 
-static inline int RelayProtector_lostInShift(uint64_t bitfield, int shiftAmount)
+/** Count the set bits in the lowest shiftAmount bits of the window. */
+static inline int ReplayProtector_popCountLow(const uint64_t* bitfield, int shiftAmount)
+{
+    int count = 0;
+    for (int w = 0; w < ReplayProtector_WORDS && shiftAmount > 0; w++, shiftAmount -= 64) {
+        uint64_t word = bitfield[w];
+        if (shiftAmount < 64) { word <<= (64 - shiftAmount); }
+        count += Bits_popCountx64(word);
+    }
+    return count;
+}
+
+static inline int RelayProtector_lostInShift(const uint64_t* bitfield, int shiftAmount)
 {
     if (shiftAmount == 0) {
         return 0;
     }
-    if (shiftAmount > 63) {
-        return shiftAmount - Bits_popCountx64(bitfield);
+    return shiftAmount - ReplayProtector_popCountLow(bitfield, shiftAmount);
+}
+
+/** Shift the whole window down by shiftAmount bits (drop the oldest entries). */
+static inline void ReplayProtector_shiftWindow(uint64_t* bitfield, uint32_t shiftAmount)
+{
+    if (shiftAmount >= ReplayProtector_WINDOW) {
+        for (int w = 0; w < ReplayProtector_WORDS; w++) { bitfield[w] = 0; }
+        return;
+    }
+    const int words = shiftAmount >> 6;
+    const int bits = shiftAmount & 63;
+    for (int w = 0; w < ReplayProtector_WORDS; w++) {
+        uint64_t out = (w + words < ReplayProtector_WORDS) ? bitfield[w + words] : 0;
+        if (bits) {
+            out >>= bits;
+            if (w + words + 1 < ReplayProtector_WORDS) {
+                out |= bitfield[w + words + 1] << (64 - bits);
+            }
+        }
+        bitfield[w] = out;
     }
-    return shiftAmount - Bits_popCountx64(bitfield << (64 - shiftAmount));
 }
 
 /**
@@ -72,34 +106,28 @@ static inline bool ReplayProtector_checkNonce(const uint32_t nonce, struct Repla
 
     uint32_t offset = nonce - context->baseOffset;
 
-    while (offset > 63) {
-
-        #define ReplayProtector_DO_SHIFT(bits) \
-            context->baseOffset += (bits);     \
-            if ((bits) > 63) {                 \
-                context->bitfield = 0;         \
-            } else {                           \
-                context->bitfield >>= (bits);  \
-            }                                  \
-            offset -= (bits);
-
-        if ((context->bitfield & 0xffffffffu) == 0xffffffffu) {
+    while (offset > ReplayProtector_WINDOW - 1) {
+        if ((context->bitfield[0] & 0xffffffffu) == 0xffffffffu) {
             // happy path, low 32 bits are checked in, rotate and continue.
-            ReplayProtector_DO_SHIFT(32);
-
+            ReplayProtector_shiftWindow(context->bitfield, 32);
+            context->baseOffset += 32;
+            offset -= 32;
         } else {
-            // we are going to have to accept some losses, take offset - 47 to mitigate that
-            // as much as possible.
-            context->lostPackets += RelayProtector_lostInShift(context->bitfield, offset - 47);
-            ReplayProtector_DO_SHIFT(offset - 47);
+            // we are going to have to accept some losses, shift as little as
+            // possible (leave 16 bits of headroom) to mitigate that.
+            uint32_t shift = offset - (ReplayProtector_WINDOW - 17);
+            context->lostPackets += RelayProtector_lostInShift(context->bitfield, shift);
+            ReplayProtector_shiftWindow(context->bitfield, shift);
+            context->baseOffset += shift;
+            offset -= shift;
         }
     }
 
-    if (context->bitfield & (((uint64_t)1) << offset)) {
+    if (context->bitfield[offset >> 6] & (((uint64_t)1) << (offset & 63))) {
         context->duplicates++;
         return false;
     }
-    context->bitfield |= (((uint64_t)1) << offset);
+    context->bitfield[offset >> 6] |= (((uint64_t)1) << (offset & 63));
     return true;
 }
 
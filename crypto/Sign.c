@@ -171,11 +171,22 @@ void Sign_signMsg(uint8_t keyPair[64], struct Message* msg, struct Random* rand)
 int Sign_verifyMsg(uint8_t publicSigningKey[32], struct Message* msg)
 {
     if (Message_getLength(msg) < 64) { return -1; }
-    struct Allocator* alloc = Allocator_child(Message_getAlloc(msg));
-    uint8_t* buff = Allocator_malloc(alloc, Message_getLength(msg));
     unsigned long long ml = Message_getLength(msg);
-    int ret = crypto_sign_ed25519_open(buff, &ml, msg->msgbytes, Message_getLength(msg), publicSigningKey);
-    Allocator_free(alloc);
+    int ret;
+    // sign_open needs somewhere to write the opened message, which is thrown
+    // away; announce-sized messages fit on the stack, only jumbo ones pay for
+    // an allocation.
+    uint8_t stackBuff[1536];
+    if (ml <= sizeof(stackBuff)) {
+        ret = crypto_sign_ed25519_open(
+            stackBuff, &ml, msg->msgbytes, Message_getLength(msg), publicSigningKey);
+    } else {
+        struct Allocator* alloc = Allocator_child(Message_getAlloc(msg));
+        uint8_t* buff = Allocator_malloc(alloc, Message_getLength(msg));
+        ret = crypto_sign_ed25519_open(
+            buff, &ml, msg->msgbytes, Message_getLength(msg), publicSigningKey);
+        Allocator_free(alloc);
+    }
     if (ret) {
         return -1;
     }
@@ -93,7 +93,7 @@
  */
 
 /** How many bytes to buffer so requests for a small amount of random do not invoke salsa20. */
-#define BUFFSIZE 128
+#define BUFFSIZE 512
 
 /** The key material which is used to generate the temporary seed. */
 union Random_SeedGen
@@ -281,3 +281,24 @@ struct Random* Random_new(struct Allocator* alloc, struct Log* logger, struct Ex
     RandomSeed_t* rs = SystemRandomSeed_new(NULL, 0, logger, alloc);
     return Random_newWithSeed(alloc, logger, rs, eh);
 }
+
+struct Random* Random_fork(struct Random* parent, struct Allocator* alloc)
+{
+    Identity_check(parent);
+    union Random_SeedGen* seedGen = Allocator_calloc(alloc, sizeof(union Random_SeedGen), 1);
+    Random_bytes(parent, (uint8_t*)seedGen->buff, sizeof(union Random_SeedGen));
+
+    struct Random* rand = Allocator_calloc(alloc, sizeof(struct Random), 1);
+    rand->seedGen = seedGen;
+    rand->seed = parent->seed;
+    rand->alloc = alloc;
+    rand->log = parent->log;
+
+    Identity_set(rand);
+
+    rand->addRandomCounter = 255;
+    Random_addRandom(rand, 0);
+    stir(rand);
+
+    return rand;
+}
@@ -108,4 +108,12 @@ struct Random* Random_newWithSeed(struct Allocator* alloc,
 
 struct Random* Random_new(struct Allocator* alloc, struct Log* logger, struct Except* eh);
 
+/**
+ * Create a per-purpose generator seeded from an existing one.
+ * Forking is cheap (no operating system reseed) and gives a subsystem its own
+ * buffer, so a consumer with bursty demand does not drain the buffer that the
+ * security-sensitive users share.
+ */
+struct Random* Random_fork(struct Random* parent, struct Allocator* alloc);
+
 #endif
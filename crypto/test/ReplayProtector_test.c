@@ -26,7 +26,7 @@ static void testDuplicates(struct Random* rand)
 {
     uint16_t randomShorts[8192];
     uint16_t out[8192];
-    struct ReplayProtector rp = {.bitfield = 0};
+    struct ReplayProtector rp = {.baseOffset = 0};
 
     Random_bytes(rand, (uint8_t*)randomShorts, sizeof(randomShorts));
 
@@ -45,13 +45,52 @@ static void testDuplicates(struct Random* rand)
     }
 }
 
+static void testCrossWordBoundaries()
+{
+    struct ReplayProtector rp = {.baseOffset = 0};
+
+    // a monotone run across the whole window and beyond must all land
+    for (uint32_t n = 0; n < ReplayProtector_WINDOW * 4; n++) {
+        Assert_true(ReplayProtector_checkNonce(n, &rp));
+        Assert_true(!ReplayProtector_checkNonce(n, &rp));
+    }
+    Assert_true(rp.lostPackets == 0);
+
+    // straddle every word boundary of a fresh window
+    struct ReplayProtector rp2 = {.baseOffset = 0};
+    for (uint32_t i = 1; i <= ReplayProtector_WINDOW / 64; i++) {
+        uint32_t boundary = i * 64;
+        Assert_true(ReplayProtector_checkNonce(boundary - 1, &rp2));
+        if (boundary < ReplayProtector_WINDOW) {
+            Assert_true(ReplayProtector_checkNonce(boundary, &rp2));
+            Assert_true(!ReplayProtector_checkNonce(boundary, &rp2));
+        }
+        Assert_true(!ReplayProtector_checkNonce(boundary - 1, &rp2));
+    }
+
+    // reordered delivery spanning word boundaries within the window
+    struct ReplayProtector rp3 = {.baseOffset = 0};
+    for (int n = ReplayProtector_WINDOW - 1; n >= 0; n--) {
+        Assert_true(ReplayProtector_checkNonce(n, &rp3));
+    }
+    Assert_true(rp3.lostPackets == 0 && rp3.duplicates == 0);
+
+    // a jump far past the window clears it and old nonces become untrackable
+    struct ReplayProtector rp4 = {.baseOffset = 0};
+    Assert_true(ReplayProtector_checkNonce(0, &rp4));
+    Assert_true(ReplayProtector_checkNonce(1000000, &rp4));
+    Assert_true(!ReplayProtector_checkNonce(1000000, &rp4));
+    Assert_true(!ReplayProtector_checkNonce(0, &rp4));
+}
+
 int main()
 {
-    struct Allocator* alloc = MallocAllocator_new(4096);
+    struct Allocator* alloc = MallocAllocator_new(16384);
     struct Random* rand = Random_new(alloc, NULL, NULL);
     for (int i = 0; i < CYCLES; i++) {
         testDuplicates(rand);
     }
+    testCrossWordBoundaries();
     Allocator_free(alloc);
     return 0;
 }
@@ -594,11 +594,19 @@ static bool tryRandomLink(struct Janitor_pvt* janitor)
     return false;
 }
 
+/**
+ * Budget for one maintenance cycle. When a cycle runs long the remaining
+ * steps are skipped; the mills and the least-recently-pinged rotation make
+ * sure the skipped work comes up again next cycle.
+ */
+#define CYCLE_BUDGET_NANOS (2 * 1000 * 1000)
+
 static void maintanenceCycle(void* vcontext)
 {
     struct Janitor_pvt* const janitor = Identity_check((struct Janitor_pvt*) vcontext);
 
     uint64_t now = Time_currentTimeMilliseconds();
+    uint64_t cycleStart = Time_hrtime();
 
     uint64_t nextTimeout = (janitor->pub.localMaintainenceMilliseconds / 2);
     nextTimeout += Random_uint32(janitor->rand) % (nextTimeout * 2);
@@ -637,9 +645,18 @@ static void maintanenceCycle(void* vcontext)
         //Log_debug(janitor->logger, "Could not find anything to do");
     }
 
+    if (Time_hrtime() - cycleStart > CYCLE_BUDGET_NANOS) {
+        // Over budget already, the rest of the work waits for the next cycle.
+        return;
+    }
+
     // Try to ping the existing node we have heard from least recently.
     tryExistingNode(janitor);
 
+    if (Time_hrtime() - cycleStart > CYCLE_BUDGET_NANOS) {
+        return;
+    }
+
     // Look for better nodes for the dht.
     keyspaceMaintenance(janitor);
 
@@ -51,6 +51,12 @@ struct Node_Two
     /** The encoding method used by this node. */
     struct EncodingScheme* encodingScheme;
 
+    /** Compiled form of encodingScheme, NULL if the scheme could not be compiled. */
+    struct EncodingScheme_Compiled* compiledScheme;
+
+    /** Next node in NodeStore's marked-node worklist, only valid while marked. */
+    struct Node_Two* nextMarked;
+
     /**
      * Peers of this node for which we know the forward direction.
      * Use RB_NFIND(PeerRBTree, node->peerTree, struct type* elm)
@@ -15,6 +15,7 @@
 #include "dht/Address.h"
 #include "dht/dhtcore/Node.h"
 #include "dht/dhtcore/NodeStore.h"
+#include "crypto/AddressCalc.h"
 #include "dht/dhtcore/NodeList.h"
 #include "util/AddrTools.h"
 #include "util/Assert.h"
@@ -50,6 +51,16 @@ struct NodeStore_pvt
      */
     struct Node_Link* linksToFree;
 
+    /**
+     * Recycled links, chained through nextPeer. Links churn constantly as
+     * paths split and decay; reusing them keeps the link working set in a
+     * stable patch of memory instead of bouncing through the allocator.
+     */
+    struct Node_Link* linkFreeList;
+
+    /** Worklist of nodes marked for best-parent recomputation, see findBestParent(). */
+    struct Node_Two* markedList;
+
     /** Nodes which have very likely been reset. */
     struct RumorMill* renumberMill;
 
@@ -109,13 +120,21 @@ RB_GENERATE_STATIC(NodeRBTree, Node_Two, nodeTree, compareNodes)
 
 static void freeLink(struct Node_Link* link, struct NodeStore_pvt* store)
 {
-    Allocator_realloc(store->alloc, link, 0);
+    Bits_memset(link, 0, sizeof(struct Node_Link));
+    link->nextPeer = store->linkFreeList;
+    store->linkFreeList = link;
     store->pub.linkCount--;
 }
 
 static struct Node_Link* getLink(struct NodeStore_pvt* store)
 {
     store->pub.linkCount++;
+    struct Node_Link* link = store->linkFreeList;
+    if (link) {
+        store->linkFreeList = link->nextPeer;
+        link->nextPeer = NULL;
+        return link;
+    }
     return Allocator_calloc(store->alloc, sizeof(struct Node_Link), 1);
 }
 
@@ -425,7 +444,11 @@ static bool findBestParent0(struct Node_Two* node, struct NodeStore_pvt* store)
         struct Node_Link* link = NULL;
         RB_FOREACH(link, PeerRBTree, &node->peerTree) {
             if (Node_getCost(node) > bestCost || Node_getBestParent(link->child) == link) {
-                link->child->marked = 1;
+                if (!link->child->marked) {
+                    link->child->marked = 1;
+                    link->child->nextMarked = store->markedList;
+                    store->markedList = link->child;
+                }
             }
         }
         setParentCostAndPath(node, bestLink, bestCost, bestPath, store);
@@ -439,20 +462,21 @@ static bool findBestParent(struct Node_Two* node, struct NodeStore_pvt* store)
 {
     uint64_t time0 = Time_hrtime();
     if (!findBestParent0(node, store)) { return false; }
-    int ret = 0;
+    // Drain the worklist which findBestParent0() pushes affected children onto,
+    // so only nodes whose path can actually have changed are revisited rather
+    // than rescanning the whole store until a pass comes up empty.
+    // If setParentCostAndPath()'s change callback somehow re-enters here, the
+    // nested call just drains the shared list and the outer loop exits early,
+    // so no entry precondition is asserted.
     int cycle = 0;
-    do {
-        Assert_true(cycle++ < 10000);
-        ret = 0;
-        for (struct Node_Two* n = NodeStore_getNextNode(&store->pub, NULL);
-             n;
-             n = NodeStore_getNextNode(&store->pub, n))
-        {
-            if (n->marked) {
-                ret |= findBestParent0(n, store);
-            }
-        }
-    } while (ret);
+    while (store->markedList) {
+        Assert_true(cycle++ < 10000000);
+        struct Node_Two* n = store->markedList;
+        store->markedList = n->nextMarked;
+        n->nextMarked = NULL;
+        Assert_ifParanoid(n->marked);
+        findBestParent0(n, store);
+    }
     uint64_t time1 = Time_hrtime();
     if ((int64_t)(time1 - time0) > 1000000) {
         Log_warn(store->logger, "\n\nfindBestParent() took [%lld] ms\n\n",
@@ -665,6 +689,23 @@ static struct Node_Link* linkNodes(struct Node_Two* parent,
 
 #define removeLinkFromLabel_IMPOSSIBLE UINT64_MAX
 #define removeLinkFromLabel_OVERSIZE (UINT64_MAX-1)
+/** Form lookup through the node's compiled scheme when one exists. */
+static int nodeFormNum(struct Node_Two* node, uint64_t label)
+{
+    if (node->compiledScheme) {
+        return EncodingScheme_getFormNumCompiled(node->compiledScheme, label);
+    }
+    return EncodingScheme_getFormNum(node->encodingScheme, label);
+}
+
+static uint64_t nodeConvertLabel(struct Node_Two* node, uint64_t label, int convertTo)
+{
+    if (node->compiledScheme) {
+        return EncodingScheme_convertLabelCompiled(node->compiledScheme, label, convertTo);
+    }
+    return EncodingScheme_convertLabel(node->encodingScheme, label, convertTo);
+}
+
 #define removeLinkFromLabel_ERR(x) (((uint64_t)x) >> 63)
 // TODO(cjd): This does not depend on nodeStore or alter the link, consider moving to Node.c
 static uint64_t removeLinkFromLabel(struct Node_Link* link, uint64_t label)
@@ -672,7 +713,7 @@ static uint64_t removeLinkFromLabel(struct Node_Link* link, uint64_t label)
     // First we splice off the parent's Director leaving the child's Director.
     uint64_t unspliced = LabelSplicer_unsplice(label, link->cannonicalLabel);
 
-    int formNum = EncodingScheme_getFormNum(link->child->encodingScheme, unspliced);
+    int formNum = nodeFormNum(link->child, unspliced);
 
     if (formNum < link->inverseLinkEncodingFormNumber) {
         // Can't get there from here.
@@ -680,9 +721,7 @@ static uint64_t removeLinkFromLabel(struct Node_Link* link, uint64_t label)
     }
 
     uint64_t cannonical =
-        EncodingScheme_convertLabel(link->child->encodingScheme,
-                                    unspliced,
-                                    EncodingScheme_convertLabel_convertTo_CANNONICAL);
+        nodeConvertLabel(link->child, unspliced, EncodingScheme_convertLabel_convertTo_CANNONICAL);
 
     // Check that they didn't waste space by sending an oversize encoding form.
     if (formNum > link->inverseLinkEncodingFormNumber && cannonical != unspliced) {
@@ -972,9 +1011,9 @@ static void fixLink(struct Node_Link* parentLink,
                 LabelSplicer_unsplice(splitLink->cannonicalLabel, parentLink->cannonicalLabel);
             Assert_true(parentLink->child);
             childToGrandchild =
-                EncodingScheme_convertLabel(parentLink->child->encodingScheme,
-                                            childToGrandchild,
-                                            EncodingScheme_convertLabel_convertTo_CANNONICAL);
+                nodeConvertLabel(parentLink->child,
+                                 childToGrandchild,
+                                 EncodingScheme_convertLabel_convertTo_CANNONICAL);
 
             Assert_true(childToGrandchild < UINT64_MAX);
             Assert_true(childToGrandchild != 1);
@@ -1165,6 +1204,10 @@ static bool markNodesForBucket(struct NodeStore_pvt* store,
 
     for (uint32_t i = 0; i < nodeList->size; i++) {
         // Now mark the nodes in the list to protect them.
+        // These marks are scan-local: getWorstNode() clears every one before
+        // returning, so they never coexist with findBestParent()'s worklist
+        // (which is likewise empty outside that function) and deliberately
+        // bypass it.
         Identity_check(nodeList->nodes[i]);
         nodeList->nodes[i]->marked = 1;
     }
@@ -1198,6 +1241,8 @@ static struct Node_Two* getWorstNode(struct NodeStore_pvt* store)
         // first cycle we set markings so markings remain if they are behind us
         struct Node_Link* parentLink = Node_getBestParent(nn);
         if (parentLink) {
+            // Scan-local mark, cleared below before returning; it must not go
+            // through the findBestParent() worklist.
             parentLink->parent->marked = 1;
         } else if (!worst || whichIsWorse(nn, worst, store) == nn) {
             // this time around we're only addressing nodes which are unreachable.
@@ -1358,6 +1403,7 @@ static struct Node_Link* discoverNode(struct NodeStore_pvt* store,
         child->alloc = alloc;
         Bits_memcpy(&child->address, addr, sizeof(struct Address));
         child->encodingScheme = EncodingScheme_clone(scheme, child->alloc);
+        child->compiledScheme = EncodingScheme_compile(child->encodingScheme, child->alloc);
         child->timeLastPinged = Time_currentTimeMilliseconds();
         Identity_set(child);
     }
@@ -1635,6 +1681,7 @@ struct NodeStore* NodeStore_new(struct Address* myAddress,
     Assert_true(myAddress);
     Bits_memcpy(&selfNode->address, myAddress, sizeof(struct Address));
     selfNode->encodingScheme = NumberCompress_defineScheme(alloc);
+    selfNode->compiledScheme = EncodingScheme_compile(selfNode->encodingScheme, alloc);
     selfNode->alloc = alloc;
     Identity_set(selfNode);
     out->pub.selfNode = selfNode;
@@ -2107,6 +2154,16 @@ void NodeStore_pathTimeout(struct NodeStore* nodeStore, uint64_t path)
     }
 }
 
+void NodeStore_warmStartNode(struct NodeStore* nodeStore, struct Address* addr)
+{
+    struct NodeStore_pvt* store = Identity_check((struct NodeStore_pvt*)nodeStore);
+    if (!addr->path || !addr->protocolVersion) { return; }
+    if (!AddressCalc_validAddress(addr->ip6.bytes)) { return; }
+    // Do not trust the snapshot: the mill will ping the node and it enters the
+    // store through the normal discovery path only if it answers.
+    RumorMill_addNode(store->renumberMill, addr);
+}
+
 struct Address NodeStore_addrForBucket(struct Address* source, uint16_t bucket)
 {
     Assert_compileTime(NodeStore_bucketNumber == 128);
@@ -226,6 +226,13 @@ uint64_t NodeStore_timeSinceLastPing(struct NodeStore* nodeStore, struct Node_Tw
 // Used for DHT maintenance.
 #define NodeStore_bucketSize 4
 #define NodeStore_bucketNumber 128
+/**
+ * Offer a node from a saved table snapshot for warm start.
+ * The address is only queued for pinging; it enters the store through the
+ * normal discovery path if and when it responds.
+ */
+void NodeStore_warmStartNode(struct NodeStore* nodeStore, struct Address* addr);
+
 struct Address NodeStore_addrForBucket(struct Address* source, uint16_t bucket);
 uint16_t NodeStore_bucketForAddr(struct Address* source, struct Address* dest);
 struct NodeList* NodeStore_getNodesForBucket(struct NodeStore* nodeStore,
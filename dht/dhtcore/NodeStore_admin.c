@@ -16,6 +16,8 @@
 #include "benc/Dict.h"
 #include "benc/String.h"
 #include "benc/Int.h"
+#include "benc/List.h"
+#include "dht/Address.h"
 #include "crypto/Key.h"
 #include "dht/dhtcore/Node.h"
 #include "dht/dhtcore/NodeStore.h"
@@ -34,16 +36,44 @@ struct Context {
 
 
 #define ENTRIES_PER_PAGE 4
+
+/** Page size when the client drives the dump with a cursor. */
+#define ENTRIES_PER_CURSOR_PAGE 64
+
 static void dumpTable(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
 {
     struct Context* ctx = Identity_check((struct Context*) vcontext);
     int64_t* page = Dict_getIntC(args, "page");
     int ctr = (page) ? *page * ENTRIES_PER_PAGE : 0;
+    int limit = ctr + ENTRIES_PER_PAGE;
 
     Dict* out = Dict_new(requestAlloc);
-    List* table = List_new(requestAlloc);
     struct Node_Two* nn = NULL;
-    for (int i = 0; i < ctr+ENTRIES_PER_PAGE; i++) {
+
+    // Cursor mode: resume directly behind the last node of the previous reply
+    // (one tree lookup) instead of re-walking the table from the top, and use
+    // bigger pages. The cursor is the ip of the last node returned.
+    String* cursor = Dict_getStringC(args, "cursor");
+    if (cursor) {
+        uint8_t ip6[16];
+        if (cursor->len < 39 || AddrTools_parseIp(ip6, (uint8_t*) cursor->bytes)) {
+            Dict_putStringCC(out, "error", "unparsable cursor", requestAlloc);
+            Admin_sendMessage(out, txid, ctx->admin);
+            return;
+        }
+        nn = NodeStore_nodeForAddr(ctx->store, ip6);
+        if (!nn) {
+            // node vanished between requests, the client must restart the dump
+            Dict_putStringCC(out, "error", "stale cursor", requestAlloc);
+            Admin_sendMessage(out, txid, ctx->admin);
+            return;
+        }
+        ctr = 0;
+        limit = ENTRIES_PER_CURSOR_PAGE;
+    }
+
+    List* table = List_new(requestAlloc);
+    for (int i = 0; i < limit; i++) {
         nn = NodeStore_getNextNode(ctx->store, nn);
         if (!nn) { break; }
         if (i < ctr) { continue; }
@@ -79,6 +109,9 @@ static void dumpTable(Dict* args, void* vcontext, String* txid, struct Allocator
 
     if (nn) {
         Dict_putIntC(out, "more", 1, requestAlloc);
+        String* nextCursor = String_newBinary(NULL, 39, requestAlloc);
+        Address_printIp(nextCursor->bytes, &nn->address);
+        Dict_putStringC(out, "cursor", nextCursor, requestAlloc);
     }
     Dict_putIntC(out, "count", ctx->store->nodeCount, requestAlloc);
     Dict_putIntC(out, "peers", ctx->store->peerCount, requestAlloc);
@@ -299,6 +332,29 @@ static void getRouteLabel(Dict* args, void* vcontext, String* txid, struct Alloc
     }
 }
 
+static void warmStart(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
+{
+    struct Context* ctx = Identity_check((struct Context*) vcontext);
+    List* nodes = Dict_getListC(args, "nodes");
+    int queued = 0;
+    int failed = 0;
+    const int numNodes = List_size(nodes);
+    for (int i = 0; i < numNodes; i++) {
+        String* nodeStr = List_getString(nodes, i);
+        struct Address* addr = (nodeStr) ? Address_fromString(nodeStr, requestAlloc) : NULL;
+        if (!addr) {
+            failed++;
+            continue;
+        }
+        NodeStore_warmStartNode(ctx->store, addr);
+        queued++;
+    }
+    Dict* out = Dict_new(requestAlloc);
+    Dict_putIntC(out, "queued", queued, requestAlloc);
+    Dict_putIntC(out, "failed", failed, requestAlloc);
+    Admin_sendMessage(out, txid, ctx->admin);
+}
+
 static void getFullVerify(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
 {
     struct Context* ctx = Identity_check((struct Context*) vcontext);
@@ -353,4 +409,9 @@ void NodeStore_admin_register(struct NodeStore* nodeStore,
             { .name = "fullVerify", .required = true, .type = "Int" },
         }), admin);
     Admin_registerFunction("NodeStore_getFullVerify", getFullVerify, ctx, false, NULL, admin);
+
+    Admin_registerFunction("NodeStore_warmStart", warmStart, ctx, true,
+        ((struct Admin_FunctionArg[]) {
+            { .name = "nodes", .required = 1, .type = "List" }
+        }), admin);
 }
@@ -697,6 +697,11 @@ uint32_t RouterModule_globalMeanResponseTime(struct RouterModule* module)
     return (uint32_t) AverageRoller_getAverage(module->gmrtRoller);
 }
 
+uint32_t RouterModule_globalResponseTimePercentile(struct RouterModule* module, uint32_t percentile)
+{
+    return AverageRoller_getPercentile(module->gmrtRoller, percentile);
+}
+
 void RouterModule_peerIsReachable(uint64_t pathToPeer,
                                   uint64_t lagMilliseconds,
                                   struct RouterModule* module)
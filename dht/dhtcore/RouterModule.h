@@ -115,6 +115,15 @@ struct Node_Two* RouterModule_nodeForPath(uint64_t path, struct RouterModule* mo
 
 uint32_t RouterModule_globalMeanResponseTime(struct RouterModule* module);
 
+/**
+ * Get a percentile of the response times over the mean-response-time window.
+ * The result is quantized to power-of-two bucket bounds, meant to be cheap
+ * enough to poll; a p99 far above the mean indicates a latency tail which
+ * the average alone would hide.
+ */
+uint32_t RouterModule_globalResponseTimePercentile(struct RouterModule* module,
+                                                   uint32_t percentile);
+
 struct RouterModule_Promise* RouterModule_nextHop(struct Address* whoToAsk,
                                                   uint8_t target[16],
                                                   uint32_t timeoutMilliseconds,
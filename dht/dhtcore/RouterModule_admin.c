@@ -35,6 +35,19 @@ struct Context {
     Identity
 };
 
+static void gmrt(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
+{
+    struct Context* ctx = vcontext;
+    Dict* out = Dict_new(requestAlloc);
+    Dict_putIntC(out, "averageMs",
+        RouterModule_globalMeanResponseTime(ctx->module), requestAlloc);
+    Dict_putIntC(out, "p50Ms",
+        RouterModule_globalResponseTimePercentile(ctx->module, 50), requestAlloc);
+    Dict_putIntC(out, "p99Ms",
+        RouterModule_globalResponseTimePercentile(ctx->module, 99), requestAlloc);
+    Admin_sendMessage(out, txid, ctx->admin);
+}
+
 static void lookup(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
 {
     struct Context* ctx = vcontext;
@@ -358,6 +371,8 @@ void RouterModule_admin_register(struct RouterModule* module,
             { .name = "timeout", .required = 0, .type = "Int" }
         }), admin);
 
+    Admin_registerFunction("RouterModule_gmrt", gmrt, ctx, true, NULL, admin);
+
     Admin_registerFunction("RouterModule_lookup", lookup, ctx, true,
         ((struct Admin_FunctionArg[]) {
             { .name = "address", .required = 1, .type = "String" }
@@ -36,11 +36,32 @@ struct RumorMill_pvt
 
     int capacity;
 
+    /**
+     * Per-entry fingerprints (path mixed with the key) kept in step with
+     * addresses[]. The duplicate scan walks this flat array and only does the
+     * full compare on a fingerprint hit.
+     */
+    uint64_t* fingerprints;
+
+    /**
+     * Per-entry badness, computed once on insert so that the best/worst scans
+     * are flat integer sweeps the compiler can vectorize instead of repeated
+     * log2 computations behind pointer loads.
+     */
+    int* badness;
+
     struct Log* log;
 
     Identity
 };
 
+static uint64_t fingerprint(struct Address* addr)
+{
+    uint64_t key[4];
+    Bits_memcpy(key, addr->key, 32);
+    return addr->path ^ key[0] ^ key[1] ^ key[2] ^ key[3];
+}
+
 static int getBadness(struct Address* badAddr, struct Address* selfAddr)
 {
     uint64_t xor = Endian_bigEndianToHost64(badAddr->ip6.longs.one_be ^ selfAddr->ip6.longs.one_be);
@@ -49,33 +70,30 @@ static int getBadness(struct Address* badAddr, struct Address* selfAddr)
 
 static struct Address* getWorst(struct RumorMill_pvt* rm)
 {
-    struct Address* worst = NULL;
+    int worst = -1;
     int howBadIsTheWorst = 0;
     for (int i = 0; i < rm->pub.count; i++) {
-        int howBad = getBadness(&rm->pub.addresses[i], rm->selfAddr);
-        if (howBad > howBadIsTheWorst) {
-            howBadIsTheWorst = howBad;
-            worst = &rm->pub.addresses[i];
+        if (rm->badness[i] > howBadIsTheWorst) {
+            howBadIsTheWorst = rm->badness[i];
+            worst = i;
         }
     }
-    Assert_true(worst);
-    return worst;
+    Assert_true(worst > -1);
+    return &rm->pub.addresses[worst];
 }
 
 static struct Address* getBest(struct RumorMill_pvt* rm)
 {
     if (rm->pub.count == 0) { return NULL; }
-    struct Address* best = NULL;
-    int howBadIsTheBest = -1;
-    for (int i = 0; i < rm->pub.count; i++) {
-        int howBad = getBadness(&rm->pub.addresses[i], rm->selfAddr);
-        if (howBad < howBadIsTheBest || !best) {
-            howBadIsTheBest = howBad;
-            best = &rm->pub.addresses[i];
+    int best = 0;
+    int howBadIsTheBest = rm->badness[0];
+    for (int i = 1; i < rm->pub.count; i++) {
+        if (rm->badness[i] < howBadIsTheBest) {
+            howBadIsTheBest = rm->badness[i];
+            best = i;
         }
     }
-    Assert_true(best);
-    return best;
+    return &rm->pub.addresses[best];
 }
 
 void RumorMill__addNode(struct RumorMill* mill, struct Address* addr, const char* file, int line)
@@ -85,8 +103,10 @@ void RumorMill__addNode(struct RumorMill* mill, struct Address* addr, const char
     Address_getPrefix(addr);
     Assert_true(addr->protocolVersion);
 
+    const uint64_t fp = fingerprint(addr);
     for (int i = 0; i < rm->pub.count; i++) {
-        if (rm->pub.addresses[i].path == addr->path &&
+        if (rm->fingerprints[i] == fp &&
+            rm->pub.addresses[i].path == addr->path &&
             !Bits_memcmp(rm->pub.addresses[i].key, addr->key, 32))
         {
             return;
@@ -102,6 +122,8 @@ void RumorMill__addNode(struct RumorMill* mill, struct Address* addr, const char
         replace = getWorst(rm);
     }
     Bits_memcpy(replace, addr, sizeof(struct Address));
+    rm->fingerprints[replace - rm->pub.addresses] = fp;
+    rm->badness[replace - rm->pub.addresses] = getBadness(addr, rm->selfAddr);
 
     if (Defined(Log_DEBUG)) {
         uint8_t addrStr[60];
@@ -123,6 +145,8 @@ bool RumorMill_getNode(struct RumorMill* mill, struct Address* output)
     rm->pub.count--;
     if (&rm->pub.addresses[rm->pub.count] != best) {
         Bits_memcpy(best, &rm->pub.addresses[rm->pub.count], sizeof(struct Address));
+        rm->fingerprints[best - rm->pub.addresses] = rm->fingerprints[rm->pub.count];
+        rm->badness[best - rm->pub.addresses] = rm->badness[rm->pub.count];
     }
     return true;
 }
@@ -138,6 +162,8 @@ struct RumorMill* RumorMill_new(struct Allocator* allocator,
 
     struct RumorMill_pvt* rm = Allocator_calloc(alloc, sizeof(struct RumorMill_pvt), 1);
     rm->pub.addresses = Allocator_calloc(alloc, sizeof(struct Address), capacity);
+    rm->fingerprints = Allocator_calloc(alloc, sizeof(uint64_t), capacity);
+    rm->badness = Allocator_calloc(alloc, sizeof(int), capacity);
     rm->capacity = capacity;
     rm->selfAddr = Allocator_clone(alloc, selfAddr);
     rm->log = log;
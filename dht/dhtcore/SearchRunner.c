@@ -66,6 +66,9 @@ struct SearchRunner_Search
     /** The number of requests which have been sent out so far for this search. */
     uint32_t totalRequests;
 
+    /** The number of requests currently in flight for this search. */
+    uint32_t outstandingRequests;
+
     /** Maximum number of requests to make before terminating the search. */
     uint32_t maxRequests;
 
@@ -124,6 +127,9 @@ static inline bool isDuplicateEntry(struct Address_List* list, uint32_t index)
 
 static void searchStep(struct SearchRunner_Search* search);
 
+/** Number of requests to keep in flight per search. */
+#define SEARCH_PIPELINE 3
+
 static void searchReplyCallback(struct RouterModule_Promise* promise,
                                 uint32_t lagMilliseconds,
                                 struct Address* from,
@@ -157,11 +163,6 @@ static void searchReplyCallback(struct RouterModule_Promise* promise,
             continue;
         }
 
-        if (search->lastNodeAsked.path != from->path) {
-            // old queries coming in late...
-            continue;
-        }
-
         struct Node_Two* nn =
             NodeStore_getBest(search->runner->nodeStore, nodeList->elems[i].ip6.bytes);
 
@@ -198,6 +199,8 @@ static void searchCallback(struct RouterModule_Promise* promise,
     struct SearchRunner_Search* search =
         Identity_check((struct SearchRunner_Search*)promise->userData);
 
+    search->outstandingRequests--;
+
     if (from) {
         searchReplyCallback(promise, lagMilliseconds, from, result);
     }
@@ -216,47 +219,50 @@ static void searchStep(struct SearchRunner_Search* search)
 {
     struct SearchRunner_pvt* ctx = Identity_check((struct SearchRunner_pvt*)search->runner);
 
-    struct SearchStore_Node* nextSearchNode;
-    for (;;) {
-        nextSearchNode = SearchStore_getNextNode(search->search);
+    // Keep up to SEARCH_PIPELINE requests in flight, the reply that matters is
+    // usually the fastest one anyway.
+    while (search->outstandingRequests < SEARCH_PIPELINE) {
+        struct SearchStore_Node* nextSearchNode = SearchStore_getNextNode(search->search);
 
         // If the number of requests sent has exceeded the max search requests, let's stop there.
-        if (search->totalRequests >= search->maxRequests) {
-            // fallthrough
-        } else if (search->numFinds > 0 && search->totalRequests >= search->maxRequestsIfFound) {
-            // fallthrough
-        } else if (nextSearchNode == NULL) {
-            // fallthrough
-        } else {
-            break;
-        }
-        if (search->pub.callback) {
-            search->pub.callback(&search->pub, 0, NULL, NULL);
+        if (search->totalRequests >= search->maxRequests
+            || (search->numFinds > 0 && search->totalRequests >= search->maxRequestsIfFound)
+            || nextSearchNode == NULL)
+        {
+            if (search->outstandingRequests > 0) {
+                // in-flight requests may still turn something up, the last one
+                // to complete will land back here and finish the search.
+                return;
+            }
+            if (search->pub.callback) {
+                search->pub.callback(&search->pub, 0, NULL, NULL);
+            }
+            Allocator_free(search->pub.alloc);
+            return;
         }
-        Allocator_free(search->pub.alloc);
-        return;
-    }
 
-    Bits_memcpy(&search->lastNodeAsked, &nextSearchNode->address, sizeof(struct Address));
+        Bits_memcpy(&search->lastNodeAsked, &nextSearchNode->address, sizeof(struct Address));
 
-    struct RouterModule_Promise* rp =
-        RouterModule_newMessage(&nextSearchNode->address, 0, ctx->router, search->pub.alloc);
+        struct RouterModule_Promise* rp =
+            RouterModule_newMessage(&nextSearchNode->address, 0, ctx->router, search->pub.alloc);
 
-    Dict* message = Dict_new(rp->alloc);
+        Dict* message = Dict_new(rp->alloc);
 
-    if (!Bits_memcmp(nextSearchNode->address.ip6.bytes, search->target.ip6.bytes, 16)) {
-        Dict_putString(message, CJDHTConstants_QUERY, CJDHTConstants_QUERY_GP, rp->alloc);
-    } else {
-        Dict_putString(message, CJDHTConstants_QUERY, CJDHTConstants_QUERY_FN, rp->alloc);
-    }
-    Dict_putString(message, CJDHTConstants_TARGET, search->targetStr, rp->alloc);
+        if (!Bits_memcmp(nextSearchNode->address.ip6.bytes, search->target.ip6.bytes, 16)) {
+            Dict_putString(message, CJDHTConstants_QUERY, CJDHTConstants_QUERY_GP, rp->alloc);
+        } else {
+            Dict_putString(message, CJDHTConstants_QUERY, CJDHTConstants_QUERY_FN, rp->alloc);
+        }
+        Dict_putString(message, CJDHTConstants_TARGET, search->targetStr, rp->alloc);
 
-    rp->userData = search;
-    rp->callback = searchCallback;
+        rp->userData = search;
+        rp->callback = searchCallback;
 
-    RouterModule_sendMessage(rp, message);
+        RouterModule_sendMessage(rp, message);
 
-    search->totalRequests++;
+        search->totalRequests++;
+        search->outstandingRequests++;
+    }
 }
 
 // Triggered by a search timeout (the message may still come back and will be treated as a ping)
@@ -323,6 +329,15 @@ struct RouterModule_Promise* SearchRunner_search(uint8_t target[16],
         return NULL;
     }
 
+    // Suppress duplicates: if this target is already being searched for, piling
+    // on a second identical search just burns requests.
+    for (struct SearchRunner_Search* s = runner->firstSearch; s; s = s->nextSearch) {
+        if (!Bits_memcmp(s->target.ip6.bytes, target, 16)) {
+            Log_debug(runner->logger, "Skipping search, one is already running for this target");
+            return NULL;
+        }
+    }
+
     if (maxRequests < 1) {
         maxRequests = SearchRunner_DEFAULT_MAX_REQUESTS;
     }
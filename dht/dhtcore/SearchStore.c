@@ -41,8 +41,21 @@ struct SearchStore_Search_pvt
 
     /** The nodes which have already been queried in this search. */
     struct SearchStore_Node nodesAsked[SearchStore_SEARCH_NODES];
+
+    /** Next slab on the store's freelist, only valid while retired. */
+    struct SearchStore_Search_pvt* nextFree;
 };
 
+/** Searches churn, the slabs are large, recycle them through the store. */
+static int searchOnFree(struct Allocator_OnFreeJob* job)
+{
+    struct SearchStore_Search_pvt* search = (struct SearchStore_Search_pvt*) job->userData;
+    struct SearchStore* store = search->pub.store;
+    search->nextFree = (struct SearchStore_Search_pvt*) store->freeList;
+    store->freeList = search;
+    return 0;
+}
+
 /*--------------------Functions--------------------*/
 
 /** See: SearchStore.h */
@@ -59,15 +72,21 @@ struct SearchStore_Search* SearchStore_newSearch(uint8_t searchTarget[16],
                                                  struct SearchStore* store,
                                                  struct Allocator* alloc)
 {
-    struct SearchStore_Search_pvt* search =
-        Allocator_clone(alloc, (&(struct SearchStore_Search_pvt) {
-            .pub = {
-                .callbackContext = NULL,
-                .store = store,
-                .alloc = alloc
-            }
-        }));
+    struct SearchStore_Search_pvt* search = (struct SearchStore_Search_pvt*) store->freeList;
+    if (search) {
+        store->freeList = search->nextFree;
+        Bits_memset(search, 0, sizeof(struct SearchStore_Search_pvt));
+    } else {
+        search = Allocator_calloc(store->allocator, sizeof(struct SearchStore_Search_pvt), 1);
+    }
+    struct SearchStore_Search pub = {
+        .callbackContext = NULL,
+        .store = store,
+        .alloc = alloc
+    };
+    Bits_memcpy(&search->pub, &pub, sizeof(struct SearchStore_Search));
     Bits_memcpy(search->searchTarget, searchTarget, Address_SEARCH_TARGET_SIZE);
+    Allocator_onFree(alloc, searchOnFree, search);
 
     return &search->pub;
 }
@@ -88,15 +107,38 @@ int SearchStore_addNodeToSearch(struct Address* addr, struct SearchStore_Search*
         }
     }
 
-    const uint16_t index =
-        (pvtSearch->searchStackSize < SearchStore_SEARCH_NODES)
-            // add it to the end...
-            ? pvtSearch->searchStackSize++
+    // The stack pops from the top, keep it ordered so the candidate closest in
+    // keyspace to the target sits on top regardless of the order replies come
+    // in. Keyspace distance never under-estimates the remaining hops, so the
+    // search always expands its best known frontier first.
+    struct Address target = { .path = 1 };
+    Bits_memcpy(target.ip6.bytes, pvtSearch->searchTarget, 16);
+
+    uint16_t pos = pvtSearch->searchStackSize;
+    while (pos > 0
+        && Address_closest(&target, &pvtSearch->searchStack[pos - 1], addr) < 0)
+    {
+        pos--;
+    }
 
-            // nodes are added worst-to-best so replace the last entry.
-            : pvtSearch->searchStackSize - 1;
+    if (pvtSearch->searchStackSize >= SearchStore_SEARCH_NODES) {
+        if (pos == 0) {
+            // further from the target than everything queued, drop it
+            return 0;
+        }
+        // push the worst entry off the bottom
+        Bits_memmove(&pvtSearch->searchStack[0],
+                     &pvtSearch->searchStack[1],
+                     (pos - 1) * Address_SIZE);
+        pos--;
+    } else {
+        Bits_memmove(&pvtSearch->searchStack[pos + 1],
+                     &pvtSearch->searchStack[pos],
+                     (pvtSearch->searchStackSize - pos) * Address_SIZE);
+        pvtSearch->searchStackSize++;
+    }
 
-    Bits_memcpy(&pvtSearch->searchStack[index], addr, Address_SIZE);
+    Bits_memcpy(&pvtSearch->searchStack[pos], addr, Address_SIZE);
 
     return 0;
 }
@@ -45,6 +45,9 @@ struct SearchStore
     struct Allocator* const allocator;
 
     struct Log* const logger;
+
+    /** Retired search slabs ready for reuse, see SearchStore_newSearch(). */
+    void* freeList;
 };
 
 /** Represents a single search */
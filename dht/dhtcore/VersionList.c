@@ -14,17 +14,14 @@
  */
 #include "dht/dhtcore/VersionList.h"
 #include "memory/Allocator.h"
-#include "io/Reader.h"
-#include "io/Writer.h"
-#include "io/ArrayWriter.h"
-#include "io/ArrayReader.h"
-#include "util/Endian.h"
-#include <stdio.h>
 
 struct VersionList* VersionList_parse(String* str, struct Allocator* alloc)
 {
+    if (str->len < 1) {
+        return NULL;
+    }
     const uint8_t numberSize = str->bytes[0];
-    if (str->len < 1 || numberSize == 0 || numberSize > 4) {
+    if (numberSize == 0 || numberSize > 4) {
         return NULL;
     }
 
@@ -35,12 +32,14 @@ struct VersionList* VersionList_parse(String* str, struct Allocator* alloc)
     }
 
     struct VersionList* list = VersionList_new(length, alloc);
-    struct Reader* r = ArrayReader_new(str->bytes + 1, str->len - 1, alloc);
-    for (int i = 0; i < (int)list->length; i++) {
+    const uint8_t* bytes = (const uint8_t*) &str->bytes[1];
+    for (uint32_t i = 0; i < list->length; i++) {
+        // big endian, numberSize bytes per version, no intermediate objects
         uint32_t ver = 0;
-        Reader_read(r, (uint8_t*) &ver, numberSize);
-        ver = Endian_bigEndianToHost32(ver);
-        list->versions[i] = ver >> ((4-numberSize) * 8);
+        for (int b = 0; b < numberSize; b++) {
+            ver = (ver << 8) | bytes[i * numberSize + b];
+        }
+        list->versions[i] = ver;
     }
     return list;
 }
@@ -57,16 +56,14 @@ String* VersionList_stringify(struct VersionList* list, struct Allocator* alloc)
     }
 
     String* out = String_newBinary(NULL, (numberSize * list->length + 1), alloc);
+    out->bytes[0] = numberSize;
 
-    struct Writer* w = ArrayWriter_new(out->bytes, out->len, alloc);
-    Writer_write(w, &numberSize, 1);
-
-    for (int i = 0; i < (int)list->length; i++) {
-        uint32_t ver = list->versions[i] << ((4-numberSize) * 8);
-        ver = Endian_hostToBigEndian32(ver);
-        Writer_write(w, (uint8_t*) &ver, numberSize);
+    for (uint32_t i = 0; i < list->length; i++) {
+        for (int b = 0; b < numberSize; b++) {
+            out->bytes[1 + i * numberSize + b] =
+                (list->versions[i] >> ((numberSize - 1 - b) * 8)) & 0xff;
+        }
     }
-    Writer_write(w, &numberSize, 1);
 
     return out;
 }
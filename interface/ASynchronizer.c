@@ -20,9 +20,6 @@
 #include "util/log/Log.h"
 #include "util/Hex.h"
 
-#define MAX_DRY_CYCLES 16
-
-
 #define ArrayList_TYPE struct Message
 #define ArrayList_NAME Messages
 #include "util/ArrayList.h"
@@ -40,7 +37,6 @@ struct ASynchronizer_pvt
 
     struct Allocator* timeoutAlloc;
     struct Timeout* intr;
-    int dryCycles;
 
     Identity
 };
@@ -49,14 +45,13 @@ static void timeoutTrigger(void* vASynchronizer)
 {
     struct ASynchronizer_pvt* as = Identity_check((struct ASynchronizer_pvt*) vASynchronizer);
 
-    if (!as->cycleAlloc) {
-        if (as->dryCycles++ < MAX_DRY_CYCLES || !as->timeoutAlloc) { return; }
+    // one-shot: the trigger is re-armed by the next message to arrive
+    if (as->timeoutAlloc) {
         Allocator_free(as->timeoutAlloc);
         as->timeoutAlloc = NULL;
         as->intr = NULL;
-        as->dryCycles = 0;
-        return;
     }
+    if (!as->cycleAlloc) { return; }
 
     struct ArrayList_Messages* msgsToA = as->msgsToA;
     struct ArrayList_Messages* msgsToB = as->msgsToB;
@@ -89,8 +84,11 @@ static void checkTimeout(struct ASynchronizer_pvt* as)
         as->timeoutAlloc = NULL;
     }
     if (as->timeoutAlloc) { return; }
+    // One-shot, zero delay: the whole backlog crosses over on the next loop
+    // turn instead of waiting out a millisecond tick, and an idle
+    // ASynchronizer owns no timer at all.
     as->timeoutAlloc = Allocator_child(as->alloc);
-    as->intr = Timeout_setInterval(timeoutTrigger, as, 1, as->base, as->timeoutAlloc);
+    as->intr = Timeout_setTimeout(timeoutTrigger, as, 0, as->base, as->timeoutAlloc);
 }
 
 static Iface_DEFUN fromA(struct Message* msg, struct Iface* ifA)
@@ -132,7 +132,8 @@ static Iface_DEFUN sendMessage(struct Message* msg, struct Iface* iface)
     return NULL;
 }
 
-static void handleEvent2(struct ETHInterface_pvt* context, struct Allocator* messageAlloc)
+/** @return true if a frame was pulled off the socket (keep draining). */
+static bool handleEvent2(struct ETHInterface_pvt* context, struct Allocator* messageAlloc)
 {
     struct Message* msg = Message_new(MAX_PACKET_SIZE, PADDING, messageAlloc);
 
@@ -146,13 +147,17 @@ static void handleEvent2(struct ETHInterface_pvt* context, struct Allocator* mes
     int rc = recvfrom(context->socket,
                       msg->msgbytes,
                       Message_getLength(msg),
-                      0,
+                      MSG_DONTWAIT,
                       (struct sockaddr*) &addr,
                       &addrLen);
 
+    if (rc < 0) {
+        // drained (or a transient error), wait for the next readable event
+        return false;
+    }
     if (rc < ETHInterface_Header_SIZE) {
         Log_debug(context->logger, "Failed to receive eth frame");
-        return;
+        return true;
     }
 
     Er_assert(Message_truncate(msg, rc));
@@ -165,7 +170,7 @@ static void handleEvent2(struct ETHInterface_pvt* context, struct Allocator* mes
     // here we could put a switch statement to handle different versions differently.
     if (hdr.version != ETHInterface_CURRENT_VERSION) {
         Log_debug(context->logger, "DROP unknown version");
-        return;
+        return true;
     }
 
     uint16_t reportedLength = Endian_bigEndianToHost16(hdr.length_be);
@@ -173,13 +178,13 @@ static void handleEvent2(struct ETHInterface_pvt* context, struct Allocator* mes
     if (Message_getLength(msg) != reportedLength) {
         if (Message_getLength(msg) < reportedLength) {
             Log_debug(context->logger, "DROP size field is larger than frame");
-            return;
+            return true;
         }
         Er_assert(Message_truncate(msg, reportedLength));
     }
     if (hdr.fc00_be != Endian_hostToBigEndian16(0xfc00)) {
         Log_debug(context->logger, "DROP bad magic");
-        return;
+        return true;
     }
 
     struct ETHInterface_Sockaddr  sockaddr = { .zero = 0 };
@@ -194,14 +199,21 @@ static void handleEvent2(struct ETHInterface_pvt* context, struct Allocator* mes
     Assert_true(!((uintptr_t)msg->msgbytes % 4) && "Alignment fault");
 
     Iface_send(&context->pub.generic.iface, msg);
+    return true;
 }
 
+/** Most frames to pull per readable event before yielding back to the loop. */
+#define FRAMES_PER_EVENT 64
+
 static void handleEvent(void* vcontext)
 {
     struct ETHInterface_pvt* context = Identity_check((struct ETHInterface_pvt*) vcontext);
-    struct Allocator* messageAlloc = Allocator_child(context->pub.generic.alloc);
-    handleEvent2(context, messageAlloc);
-    Allocator_free(messageAlloc);
+    for (int i = 0; i < FRAMES_PER_EVENT; i++) {
+        struct Allocator* messageAlloc = Allocator_child(context->pub.generic.alloc);
+        bool more = handleEvent2(context, messageAlloc);
+        Allocator_free(messageAlloc);
+        if (!more) { break; }
+    }
 }
 
 Er_DEFUN(List* ETHInterface_listDevices(struct Allocator* alloc))
@@ -141,12 +141,23 @@ static Iface_DEFUN receiveMessage(struct Message* msg, struct Iface* streamIf)
 
         } else {
             fi->frameAlloc = Allocator_child(fi->alloc);
-            struct Message* m = Message_new(0, Message_getLength(msg) + 4, fi->frameAlloc);
-            Message_setAssociatedFd(m, Message_getAssociatedFd(msg));
-            Er_assert(Message_epush(m, msg->msgbytes, Message_getLength(msg)));
-            Er_assert(Message_epush(m, fi->header.bytes, 4));
-
             fi->bytesRemaining -= Message_getLength(msg);
+            struct Message* m;
+            if (Message_getPadding(msg) >= 4) {
+                // The header bytes were shifted off of this stream buffer (or an
+                // earlier one), push them back on and keep the buffer itself as
+                // the first frame part instead of copying it.
+                Er_assert(Message_epush(msg, fi->header.bytes, 4));
+                Allocator_adopt(fi->frameAlloc, Message_getAlloc(msg));
+                m = msg;
+            } else {
+                // No headroom to restore the header (it arrived in a previous
+                // buffer), fall back to copying this part.
+                m = Message_new(0, Message_getLength(msg) + 4, fi->frameAlloc);
+                Message_setAssociatedFd(m, Message_getAssociatedFd(msg));
+                Er_assert(Message_epush(m, msg->msgbytes, Message_getLength(msg)));
+                Er_assert(Message_epush(m, fi->header.bytes, 4));
+            }
             fi->frameParts = Allocator_calloc(fi->frameAlloc, sizeof(struct MessageList), 1);
             fi->frameParts->msg = m;
             fi->frameParts->next = NULL;
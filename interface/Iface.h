@@ -32,6 +32,25 @@ struct Iface;
  */
 typedef struct RTypes_Error_t* (* Iface_Callback)(struct Message* message, struct Iface* thisInterface);
 
+/**
+ * Batch variant of Iface_Callback for callers which have a vector of messages on hand
+ * (e.g. a driver pulling multiple datagrams off the wire in one syscall).
+ * The receiver takes ownership of every message in the vector, just as with the single
+ * message contract. Modules which can process batches export their vector entry point
+ * explicitly (see SwitchCore_receiveMessageVec()), the struct Iface wire contract is
+ * unchanged because it is mirrored in rust/cjdns_sys/src/cffi.rs.
+ *
+ * @param messages a vector of messages, each one is owned by the callee after the call.
+ * @param count the number of messages, at most Iface_VEC_MAX.
+ * @param thisInterface the interface which the messages are sent to.
+ */
+typedef struct RTypes_Error_t* (* Iface_CallbackVec)(struct Message** messages,
+                                                     uint32_t count,
+                                                     struct Iface* thisInterface);
+
+/** The most messages which will ever be handed to an Iface_CallbackVec in one call. */
+#define Iface_VEC_MAX 64
+
 #define Iface_DEFUN __attribute__ ((warn_unused_result)) struct RTypes_Error_t*
 
 struct Iface
@@ -66,9 +85,11 @@ void Iface_checkIdentity(struct Iface* iface);
  */
 static inline struct RTypes_Error_t* Iface_send(struct Iface* iface, struct Message* msg)
 {
-    Iface_checkIdentity(iface);
+    // Inline identity checks: this is the per-hop hot path and the extern
+    // wrappers (kept for Rust) would cost two function calls per hop.
+    Identity_check(iface);
     struct Iface* conn = iface->connectedIf;
-    Iface_checkIdentity(conn);
+    Identity_check(conn);
 
     #ifdef PARANOIA
         Assert_true(conn);
@@ -89,6 +110,24 @@ static inline struct RTypes_Error_t* Iface_send(struct Iface* iface, struct Mess
     return ret;
 }
 
+/**
+ * Send a vector of messages to an Iface.
+ * If the connected interface does not export a vector entry point, this is the
+ * fallback: each message is delivered individually through Iface_send().
+ * The first error encountered is returned, the remaining messages are still delivered.
+ */
+static inline struct RTypes_Error_t* Iface_sendVec(struct Iface* iface,
+                                                   struct Message** messages,
+                                                   uint32_t count)
+{
+    struct RTypes_Error_t* err = NULL;
+    for (uint32_t i = 0; i < count; i++) {
+        struct RTypes_Error_t* e = Iface_send(iface, messages[i]);
+        if (e && !err) { err = e; }
+    }
+    return err;
+}
+
 /**
  * Forward a message from inside of an Iface_Callback function.
  */
@@ -149,8 +188,8 @@ static inline void Iface_plumb(struct Iface* a, struct Iface* b)
 {
     Assert_true(!a->connectedIf);
     Assert_true(!b->connectedIf);
-    Iface_setIdentity(a);
-    Iface_setIdentity(b);
+    Identity_set(a);
+    Identity_set(b);
     a->connectedIf = b;
     b->connectedIf = a;
 }
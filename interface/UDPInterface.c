@@ -311,6 +311,18 @@ int UDPInterface_setDSCP(struct UDPInterface* udpif, uint8_t dscp)
     return 0;
 }
 
+void UDPInterface_setBatchSize(struct UDPInterface* udpif, int batchSize)
+{
+    struct UDPInterface_pvt* ctx = Identity_check((struct UDPInterface_pvt*) udpif);
+    UDPAddrIface_setBatch(ctx->commIf, batchSize);
+}
+
+int UDPInterface_getBatchSize(struct UDPInterface* udpif)
+{
+    struct UDPInterface_pvt* ctx = Identity_check((struct UDPInterface_pvt*) udpif);
+    return UDPAddrIface_getBatch(ctx->commIf);
+}
+
 int UDPInterface_getFd(struct UDPInterface* udpif)
 {
     struct UDPInterface_pvt* ctx = Identity_check((struct UDPInterface_pvt*) udpif);
@@ -114,4 +114,12 @@ int UDPInterface_setDSCP(struct UDPInterface* udpif, uint8_t dscp);
 
 int UDPInterface_getFd(struct UDPInterface* udpif);
 
+/**
+ * Set how many datagrams are pulled off the communication socket per syscall.
+ * Only effective where the platform can batch (recvmmsg), silently capped.
+ */
+void UDPInterface_setBatchSize(struct UDPInterface* udpif, int batchSize);
+
+int UDPInterface_getBatchSize(struct UDPInterface* udpif);
+
 #endif
\ No newline at end of file
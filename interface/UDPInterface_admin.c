@@ -314,6 +314,21 @@ static void beacon(Dict* args, void* vcontext, String* txid, struct Allocator* r
     Admin_sendMessage(&out, txid, ctx->admin);
 }
 
+static void setBatchSize(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
+{
+    struct Context* ctx = Identity_check((struct Context*) vcontext);
+    struct UDPInterface* udpif = getIface(ctx, args, txid, requestAlloc, NULL);
+    if (!udpif) { return; }
+    int64_t* batchSize = Dict_getIntC(args, "batchSize");
+    if (batchSize) {
+        UDPInterface_setBatchSize(udpif, (int) *batchSize);
+    }
+    Dict* out = Dict_new(requestAlloc);
+    Dict_putIntC(out, "batchSize", UDPInterface_getBatchSize(udpif), requestAlloc);
+    Dict_putStringCC(out, "error", "none", requestAlloc);
+    Admin_sendMessage(out, txid, ctx->admin);
+}
+
 static void getFd(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
 {
     struct Context* ctx = Identity_check((struct Context*) vcontext);
@@ -390,6 +405,12 @@ void UDPInterface_admin_register(struct EventBase* base,
             { .name = "state", .required = 0, .type = "Int" }
         }), admin);
 
+    Admin_registerFunction("UDPInterface_setBatchSize", setBatchSize, ctx, true,
+        ((struct Admin_FunctionArg[]) {
+            { .name = "interfaceNumber", .required = 0, .type = "Int" },
+            { .name = "batchSize", .required = 0, .type = "Int" },
+        }), admin);
+
     Admin_registerFunction("UDPInterface_getFd", getFd, ctx, true,
         ((struct Admin_FunctionArg[]) {
             { .name = "interfaceNumber", .required = 0, .type = "Int" },
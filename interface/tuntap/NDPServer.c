@@ -30,9 +30,23 @@ struct NDPServer_pvt
     struct Iface external;
     struct Log* log;
     uint8_t localMac[Ethernet_ADDRLEN];
+
+    /**
+     * Prebuilt advert body (advert header + mac option); only the target
+     * address and checksum change per solicitation.
+     */
+    struct {
+        struct NDPHeader_NeighborAdvert na;
+        struct NDPHeader_MacOpt macOpt;
+    } advertTemplate;
+
     Identity
 };
 
+// the template must be wire-layout contiguous
+Assert_compileTime(sizeof(((struct NDPServer_pvt*)0)->advertTemplate)
+    == NDPHeader_NeighborAdvert_SIZE + NDPHeader_MacOpt_SIZE);
+
 #define MULTICAST_ADDR "\xff\x02\x00\x00\x00\x00\x00\x00\x00\x00\x00\x01\xff\x00\x00\x08"
 //                        ff  02  00  00  00  00  00  00  00  00  00  01  ff  00  00  02 870099
 #define UNICAST_ADDR   "\xfe\x80\0\0\0\0\0\0\0\0\0\0\0\0\0\x08"
@@ -82,31 +96,18 @@ static Iface_DEFUN answerNeighborSolicitation(struct Message* msg, struct NDPSer
             Message_getLength(msg));
     }
 
-    struct NDPHeader_MacOpt macOpt = {
-        .type = NDPHeader_MacOpt_type_TARGET,
-        .one = 1
-    };
-    Bits_memcpy(macOpt.mac, ns->localMac, Ethernet_ADDRLEN);
-    Er_assert(Message_epush(msg, &macOpt, sizeof(struct NDPHeader_MacOpt)));
-
-    struct NDPHeader_NeighborAdvert na = {
-        .oneThirtySix = 136,
-        .zero = 0,
-        .checksum = 0,
-        .bits = NDPHeader_NeighborAdvert_bits_ROUTER
-            | NDPHeader_NeighborAdvert_bits_SOLICITED
-            | NDPHeader_NeighborAdvert_bits_OVERRIDE
-    };
-    Bits_memcpy(na.targetAddr, sol.targetAddr, 16);
-    Er_assert(Message_epush(msg, &na, sizeof(struct NDPHeader_NeighborAdvert)));
+    // advert body from the template, only the target address is per-request
+    Er_assert(Message_epush(msg, &ns->advertTemplate, sizeof(ns->advertTemplate)));
+    struct NDPHeader_NeighborAdvert* na = (struct NDPHeader_NeighborAdvert*) msg->msgbytes;
+    Bits_memcpy(na->targetAddr, sol.targetAddr, 16);
 
     Bits_memcpy(ip6.destinationAddr, ip6.sourceAddr, 16);
     Bits_memcpy(ip6.sourceAddr, sol.targetAddr, 16);
     ip6.hopLimit = 255;
     ip6.payloadLength_be = Endian_hostToBigEndian16(Message_getLength(msg));
 
-    struct NDPHeader_RouterAdvert* adv = (struct NDPHeader_RouterAdvert*) msg->msgbytes;
-    adv->checksum = Checksum_icmp6_be(ip6.sourceAddr, msg->msgbytes, Message_getLength(msg));
+    na->checksum = 0;
+    na->checksum = Checksum_icmp6_be(ip6.sourceAddr, msg->msgbytes, Message_getLength(msg));
 
     Er_assert(Message_epush(msg, &ip6, sizeof(struct Headers_IP6Header)));
 
@@ -151,5 +152,15 @@ struct NDPServer* NDPServer_new(struct Iface* external,
     out->pub.internal.send = sendMessage;
     out->log = log;
     Bits_memcpy(out->localMac, localMac, Ethernet_ADDRLEN);
+
+    out->advertTemplate.na.oneThirtySix = 136;
+    out->advertTemplate.na.zero = 0;
+    out->advertTemplate.na.checksum = 0;
+    out->advertTemplate.na.bits = NDPHeader_NeighborAdvert_bits_ROUTER
+        | NDPHeader_NeighborAdvert_bits_SOLICITED
+        | NDPHeader_NeighborAdvert_bits_OVERRIDE;
+    out->advertTemplate.macOpt.type = NDPHeader_MacOpt_type_TARGET;
+    out->advertTemplate.macOpt.one = 1;
+    Bits_memcpy(out->advertTemplate.macOpt.mac, localMac, Ethernet_ADDRLEN);
     return &out->pub;
 }
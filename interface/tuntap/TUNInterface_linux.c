@@ -41,6 +41,14 @@
   #define DEVICE_PATH "/dev/net/tun"
 #endif
 
+// present since linux 3.8 / 4.19, may be missing from older build headers
+#ifndef IFF_MULTI_QUEUE
+  #define IFF_MULTI_QUEUE 0x0100
+#endif
+#ifndef IFF_NAPI
+  #define IFF_NAPI 0x0010
+#endif
+
 Er_DEFUN(struct Iface* TUNInterface_new(const char* interfaceName,
                                    char assignedInterfaceName[TUNInterface_IFNAMSIZ],
                                    int isTapMode,
@@ -51,7 +59,11 @@ Er_DEFUN(struct Iface* TUNInterface_new(const char* interfaceName,
     uint32_t maxNameSize = (IFNAMSIZ < TUNInterface_IFNAMSIZ) ? IFNAMSIZ : TUNInterface_IFNAMSIZ;
     Log_info(logger, "Initializing tun device [%s]", ((interfaceName) ? interfaceName : "auto"));
 
-    struct ifreq ifRequest = { .ifr_flags = (isTapMode) ? IFF_TAP : IFF_TUN };
+    // Ask for NAPI processing of userspace-injected packets and multi-queue
+    // capability (so additional queue fds can be attached later); both are
+    // optional and stripped if the kernel refuses them.
+    short baseFlags = (isTapMode) ? IFF_TAP : IFF_TUN;
+    struct ifreq ifRequest = { .ifr_flags = baseFlags | IFF_MULTI_QUEUE | IFF_NAPI };
     if (interfaceName) {
         if (strlen(interfaceName) > maxNameSize) {
             Er_raise(alloc, "tunnel name too big, limit is [%d] characters", maxNameSize);
@@ -65,9 +77,16 @@ Er_DEFUN(struct Iface* TUNInterface_new(const char* interfaceName,
     }
 
     if (ioctl(tunFd, TUNSETIFF, &ifRequest) < 0) {
-        int err = errno;
-        close(tunFd);
-        Er_raise(alloc, "ioctl(TUNSETIFF) [%s]", strerror(err));
+        // old kernel (or android's stripped tun driver), take what we can get
+        ifRequest.ifr_flags = baseFlags | IFF_MULTI_QUEUE;
+        if (ioctl(tunFd, TUNSETIFF, &ifRequest) < 0) {
+            ifRequest.ifr_flags = baseFlags;
+            if (ioctl(tunFd, TUNSETIFF, &ifRequest) < 0) {
+                int err = errno;
+                close(tunFd);
+                Er_raise(alloc, "ioctl(TUNSETIFF) [%s]", strerror(err));
+            }
+        }
     }
     if (assignedInterfaceName) {
         CString_safeStrncpy(assignedInterfaceName, ifRequest.ifr_name, maxNameSize);
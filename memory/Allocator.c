@@ -151,6 +151,27 @@ static inline void checkCanaries(struct Allocator_Allocation_pvt* alloc,
     #endif
 }
 
+/**
+ * Class c caches blocks of exactly (1024 << c) real bytes, -1 means uncacheable.
+ * Allocations below a kilobyte are not rounded or cached: they are numerous,
+ * cheap to provide and their exact sizes are part of the accounting contract.
+ * The classes cover the packet- and request-sized churn.
+ */
+static inline int sizeClassForSize(unsigned long realSize)
+{
+    if (realSize <= 512) { return -1; }
+    for (int c = 0; c < Allocator_FREE_CLASS_COUNT; c++) {
+        if (realSize <= (1024ul << c)) { return c; }
+    }
+    return -1;
+}
+
+static inline int sizeClassCap(int sizeClass)
+{
+    // bounded at ~120kB retained per class pair
+    return (sizeClass < 2) ? 32 : 8;
+}
+
 Gcc_ALLOC_SIZE(2)
 static inline void* newAllocation(struct Allocator_pvt* context,
                                   unsigned long size,
@@ -160,6 +181,11 @@ static inline void* newAllocation(struct Allocator_pvt* context,
     check(context);
     int64_t realSize = getRealSize(size);
     struct Allocator_FirstCtx* rootAlloc = Identity_check(context->rootAlloc);
+
+    // Cacheable sizes get a provider block of their full class (so released
+    // blocks are reusable) but are charged at their exact size.
+    const int sizeClass = sizeClassForSize(realSize);
+
     if (rootAlloc->spaceAvailable <= realSize) {
         failure(context, "Out of memory, limit exceeded", fileName, lineNum);
     }
@@ -167,14 +193,34 @@ static inline void* newAllocation(struct Allocator_pvt* context,
     rootAlloc->spaceAvailable -= realSize;
     context->allocatedHere += realSize;
 
-    struct Allocator_Allocation_pvt* alloc =
-        rootAlloc->provider(rootAlloc->providerContext,
-                            NULL,
-                            realSize,
-                            &context->pub);
+    if (rootAlloc->pressureCb && !rootAlloc->pressureFired
+        && rootAlloc->spaceAvailable < rootAlloc->pressureThreshold)
+    {
+        rootAlloc->pressureFired = 1;
+        rootAlloc->pressureCb(rootAlloc->pressureCtx, (unsigned long) rootAlloc->spaceAvailable);
+    }
+
+    struct Allocator_Allocation_pvt* alloc = NULL;
+    if (realSize == (int64_t)getRealSize(sizeof(struct Allocator_pvt))
+        && rootAlloc->allocatorStructFree)
+    {
+        alloc = rootAlloc->allocatorStructFree;
+        rootAlloc->allocatorStructFree = alloc->next;
+        rootAlloc->allocatorStructFreeCount--;
+    } else if (sizeClass > -1 && rootAlloc->freeClasses[sizeClass]) {
+        alloc = rootAlloc->freeClasses[sizeClass];
+        rootAlloc->freeClasses[sizeClass] = alloc->next;
+        rootAlloc->freeClassCounts[sizeClass]--;
+    } else {
+        alloc = rootAlloc->provider(rootAlloc->providerContext,
+                                    NULL,
+                                    (sizeClass > -1) ? (1024ul << sizeClass) : (uint64_t)realSize,
+                                    &context->pub);
+    }
     if (alloc == NULL) {
         failure(context, "Out of memory, malloc() returned NULL", fileName, lineNum);
     }
+    alloc->isClassBlock = (sizeClass > -1);
     alloc->next = context->allocations;
     alloc->pub.size = realSize;
     alloc->fileName = fileName;
@@ -231,16 +277,47 @@ static int removeJob(struct Allocator_OnFreeJob_pvt* job)
 
 static void releaseAllocation(struct Allocator_pvt* context,
                               struct Allocator_Allocation_pvt* allocation,
+                              struct Allocator_FirstCtx* rootAlloc,
                               Allocator_Provider provider,
                               Allocator_Provider_CONTEXT_TYPE* providerCtx)
 {
     checkCanaries(allocation, context);
 
+    // The poison memset below starts directly behind pub.size and covers the
+    // rest of this header too, so anything needed afterwards must be read now.
+    const uintptr_t isClassBlock = allocation->isClassBlock;
+
     // TODO(cjd): make this optional.
     Bits_memset(&(&allocation->pub)[1],
                 0xee,
                 allocation->pub.size - sizeof(struct Allocator_Allocation));
 
+    // NOTE: context may be poisoned already (it can live inside an allocation
+    // which was released earlier in this loop), only the rootAlloc passed down
+    // from the caller may be dereferenced here.
+    if (allocation->pub.size == getRealSize(sizeof(struct Allocator_pvt))
+        && rootAlloc->allocatorStructFreeCount < 64
+        && !rootAlloc->context.pub.isFreeing)
+    {
+        allocation->next = rootAlloc->allocatorStructFree;
+        rootAlloc->allocatorStructFree = allocation;
+        rootAlloc->allocatorStructFreeCount++;
+        return;
+    }
+
+    const int sizeClass = sizeClassForSize(allocation->pub.size);
+    if (sizeClass > -1
+        && isClassBlock
+        && rootAlloc->freeClassCounts[sizeClass] < sizeClassCap(sizeClass)
+        && !rootAlloc->context.pub.isFreeing)
+    {
+        // park it on the freelist for the next allocation of this class
+        allocation->next = rootAlloc->freeClasses[sizeClass];
+        rootAlloc->freeClasses[sizeClass] = allocation;
+        rootAlloc->freeClassCounts[sizeClass]++;
+        return;
+    }
+
     provider(providerCtx,
              &allocation->pub,
              0,
@@ -256,7 +333,15 @@ static void releaseMemory(struct Allocator_pvt* context,
         unsigned long allocatedHere = context->allocatedHere;
     #endif
 
-    Identity_check(context->rootAlloc)->spaceAvailable += context->allocatedHere;
+    struct Allocator_FirstCtx* rootAlloc = Identity_check(context->rootAlloc);
+    rootAlloc->spaceAvailable += context->allocatedHere;
+
+    if (rootAlloc->pressureFired
+        && rootAlloc->spaceAvailable > rootAlloc->pressureThreshold * 2)
+    {
+        // enough breathing room again, re-arm the notification
+        rootAlloc->pressureFired = 0;
+    }
 
     struct Allocator_Allocation_pvt* loc = context->allocations;
     while (loc != NULL) {
@@ -265,7 +350,7 @@ static void releaseMemory(struct Allocator_pvt* context,
         #endif
 
         struct Allocator_Allocation_pvt* nextLoc = loc->next;
-        releaseAllocation(context, loc, provider, providerCtx);
+        releaseAllocation(context, loc, rootAlloc, provider, providerCtx);
         loc = nextLoc;
     }
     #ifdef PARANOIA
@@ -402,28 +487,27 @@ static int pivotChildrenToAdoptedParents(struct Allocator_pvt* context, const ch
  * to the root of the tree which is being freed. They are not detached from their relevant
  * allocators because those allocators will be freed soon anyway.
  */
-static void marshalOnFreeJobs(struct Allocator_pvt* context, struct Allocator_pvt* rootToFree)
+static void marshalOnFreeJobs(struct Allocator_pvt* context,
+                              struct Allocator_pvt* rootToFree,
+                              struct Allocator_OnFreeJob_pvt*** tailP)
 {
     Assert_true(context->pub.isFreeing);
     struct Allocator_pvt* child = context->firstChild;
     while (child) {
         // Theoretically the order of free jobs is not promised but this prevents libuv crashing.
-        struct Allocator_OnFreeJob_pvt** jobP = &rootToFree->onFree;
-        while (*jobP != NULL) {
-            struct Allocator_OnFreeJob_pvt* job = *jobP;
-            jobP = &job->next;
-        }
-        *jobP = child->onFree;
+        // The tail pointer is carried through the whole recursion so collecting the jobs from
+        // a tree with many children is linear in the number of jobs.
+        **tailP = child->onFree;
         child->onFree = NULL;
 
-        while (*jobP != NULL) {
-            struct Allocator_OnFreeJob_pvt* job = *jobP;
+        while (**tailP != NULL) {
+            struct Allocator_OnFreeJob_pvt* job = **tailP;
             job->alloc = rootToFree;
-            jobP = &job->next;
+            *tailP = &job->next;
         }
 
         struct Allocator_pvt* nextChild = child->nextSibling;
-        marshalOnFreeJobs(child, rootToFree);
+        marshalOnFreeJobs(child, rootToFree, tailP);
         child = nextChild;
     }
 }
@@ -470,6 +554,28 @@ static void freeAllocator(struct Allocator_pvt* context)
     Allocator_Provider provider = rootAlloc->provider;
     Allocator_Provider_CONTEXT_TYPE* providerCtx = rootAlloc->providerContext;
 
+    if (context == &rootAlloc->context) {
+        // The whole tree is going away, give the cached blocks back.
+        struct Allocator_Allocation_pvt* sblock = rootAlloc->allocatorStructFree;
+        rootAlloc->allocatorStructFree = NULL;
+        rootAlloc->allocatorStructFreeCount = 0;
+        while (sblock) {
+            struct Allocator_Allocation_pvt* next = sblock->next;
+            provider(providerCtx, &sblock->pub, 0, NULL);
+            sblock = next;
+        }
+        for (int c = 0; c < Allocator_FREE_CLASS_COUNT; c++) {
+            struct Allocator_Allocation_pvt* block = rootAlloc->freeClasses[c];
+            rootAlloc->freeClasses[c] = NULL;
+            rootAlloc->freeClassCounts[c] = 0;
+            while (block) {
+                struct Allocator_Allocation_pvt* next = block->next;
+                provider(providerCtx, &block->pub, 0, NULL);
+                block = next;
+            }
+        }
+    }
+
     releaseMemory(context, provider, providerCtx);
     if (isTop) {
         check((struct Allocator_pvt*)rootAlloc);
@@ -511,7 +617,9 @@ void Allocator__free(struct Allocator* alloc, const char* file, int line)
     check(context);
     if (!pivotChildrenToAdoptedParents(context, file, line)) { return; }
     check(context);
-    marshalOnFreeJobs(context, context);
+    struct Allocator_OnFreeJob_pvt** jobTail = &context->onFree;
+    while (*jobTail != NULL) { jobTail = &(*jobTail)->next; }
+    marshalOnFreeJobs(context, context, &jobTail);
     check(context);
     doOnFreeJobs(context);
     check(context);
@@ -582,6 +690,7 @@ void* Allocator__realloc(struct Allocator* allocator,
         context->allocatedHere -= origLoc->pub.size;
         releaseAllocation(context,
                           origLoc,
+                          Identity_check(context->rootAlloc),
                           context->rootAlloc->provider,
                           context->rootAlloc->providerContext);
         check(context);
@@ -589,6 +698,25 @@ void* Allocator__realloc(struct Allocator* allocator,
     }
 
     size_t realSize = getRealSize(size);
+
+    // If the block came out of a size class and the new size still fits in
+    // that class, keep the block and only adjust the byte accounting.
+    if (origLoc->isClassBlock
+        && sizeClassForSize(realSize) == sizeClassForSize(origLoc->pub.size))
+    {
+        if (context->rootAlloc->spaceAvailable + origLoc->pub.size < realSize) {
+            failure(context, "Out of memory, limit exceeded.", fileName, lineNum);
+        }
+        context->rootAlloc->spaceAvailable += origLoc->pub.size;
+        context->rootAlloc->spaceAvailable -= realSize;
+        context->allocatedHere -= origLoc->pub.size;
+        context->allocatedHere += realSize;
+        origLoc->pub.size = realSize;
+        setCanaries(origLoc, context);
+        check(context);
+        return (void*) (origLoc + 1);
+    }
+
     if (context->rootAlloc->spaceAvailable + origLoc->pub.size < realSize) {
         failure(context, "Out of memory, limit exceeded.", fileName, lineNum);
     }
@@ -608,6 +736,8 @@ void* Allocator__realloc(struct Allocator* allocator,
     }
     alloc->next = nextLoc;
     alloc->pub.size = realSize;
+    // the provider realloc'd the underlying block to exactly realSize
+    alloc->isClassBlock = 0;
     *locPtr = alloc;
 
     setCanaries(alloc, context);
@@ -853,6 +983,82 @@ unsigned long Allocator_bytesAllocated(struct Allocator* allocator)
     return bytesAllocated(context);
 }
 
+static void siteProfileAdd(struct Allocator_SiteStats* sites,
+                           int maxSites,
+                           int* numSites,
+                           struct Allocator_Allocation_pvt* allocation)
+{
+    for (int i = 0; i < *numSites; i++) {
+        if (sites[i].fileName == allocation->fileName
+            && sites[i].lineNum == (int)allocation->lineNum)
+        {
+            sites[i].allocations++;
+            sites[i].bytes += allocation->pub.size;
+            return;
+        }
+    }
+    if (*numSites >= maxSites) { return; }
+    sites[*numSites].fileName = allocation->fileName;
+    sites[*numSites].lineNum = allocation->lineNum;
+    sites[*numSites].allocations = 1;
+    sites[*numSites].bytes = allocation->pub.size;
+    (*numSites)++;
+}
+
+static void siteProfileWalk(struct Allocator_pvt* context,
+                            struct Allocator_SiteStats* sites,
+                            int maxSites,
+                            int* numSites)
+{
+    for (struct Allocator_Allocation_pvt* loc = context->allocations; loc; loc = loc->next) {
+        siteProfileAdd(sites, maxSites, numSites, loc);
+    }
+    for (struct Allocator_pvt* child = context->firstChild; child; child = child->nextSibling) {
+        siteProfileWalk(child, sites, maxSites, numSites);
+    }
+}
+
+static unsigned long countAllocations(struct Allocator_pvt* context)
+{
+    unsigned long count = 0;
+    for (struct Allocator_Allocation_pvt* loc = context->allocations; loc; loc = loc->next) {
+        count++;
+    }
+    for (struct Allocator_pvt* child = context->firstChild; child; child = child->nextSibling) {
+        count += countAllocations(child);
+    }
+    return count;
+}
+
+unsigned long Allocator_allocationCount(struct Allocator* alloc)
+{
+    struct Allocator_pvt* context = Identity_check((struct Allocator_pvt*) alloc);
+    return countAllocations(context);
+}
+
+int Allocator_siteProfile(struct Allocator* alloc,
+                          struct Allocator_SiteStats* sitesOut,
+                          int maxSites)
+{
+    struct Allocator_pvt* context = Identity_check((struct Allocator_pvt*) alloc);
+    int numSites = 0;
+    siteProfileWalk(context, sitesOut, maxSites, &numSites);
+    return numSites;
+}
+
+void Allocator_onMemoryPressure(struct Allocator* alloc,
+                                unsigned long thresholdBytes,
+                                Allocator_OnPressureCallback cb,
+                                void* ctx)
+{
+    struct Allocator_pvt* context = Identity_check((struct Allocator_pvt*) alloc);
+    struct Allocator_FirstCtx* rootAlloc = Identity_check(context->rootAlloc);
+    rootAlloc->pressureCb = cb;
+    rootAlloc->pressureCtx = ctx;
+    rootAlloc->pressureThreshold = thresholdBytes;
+    rootAlloc->pressureFired = 0;
+}
+
 void Allocator_setCanary(struct Allocator* alloc, uintptr_t value)
 {
     #ifdef Allocator_USE_CANARIES
@@ -325,11 +325,35 @@ void Allocator__disown(struct Allocator* parentAlloc,
  */
 void Allocator_setCanary(struct Allocator* alloc, uintptr_t value);
 
+/**
+ * Register a callback which fires when the memory remaining under the tree's
+ * global limit falls below thresholdBytes. It fires on the allocation which
+ * crosses the threshold and re-arms once usage falls back to double the
+ * threshold, so a subsystem can shed caches instead of running the tree into
+ * the hard limit. One callback per tree; registering again replaces it.
+ */
+typedef void (* Allocator_OnPressureCallback)(void* ctx, unsigned long bytesRemaining);
+void Allocator_onMemoryPressure(struct Allocator* alloc,
+                                unsigned long thresholdBytes,
+                                Allocator_OnPressureCallback cb,
+                                void* ctx);
+
 /**
  * Get the number of bytes allocated by this allocator and all of it's children.
  */
 unsigned long Allocator_bytesAllocated(struct Allocator* allocator);
 
+/**
+ * Count the live allocations under an allocator (including children).
+ * Intended for tests asserting that an operation does not allocate more
+ * than expected:
+ *
+ *     unsigned long before = Allocator_allocationCount(alloc);
+ *     doTheThing();
+ *     Assert_true(Allocator_allocationCount(alloc) - before <= budget);
+ */
+unsigned long Allocator_allocationCount(struct Allocator* allocator);
+
 /**
  * Dump a memory snapshot to stderr.
  *
@@ -338,6 +362,24 @@ unsigned long Allocator_bytesAllocated(struct Allocator* allocator);
  */
 void Allocator_snapshot(struct Allocator* alloc, int includeAllocations);
 
+/** Aggregated live allocation data for one file/line allocation site. */
+struct Allocator_SiteStats
+{
+    const char* fileName;
+    int lineNum;
+    unsigned long allocations;
+    unsigned long bytes;
+};
+
+/**
+ * Aggregate every live allocation under alloc by the file/line which made it.
+ * Fills sitesOut with up to maxSites entries (further sites are dropped) and
+ * returns the number of entries written.
+ */
+int Allocator_siteProfile(struct Allocator* alloc,
+                          struct Allocator_SiteStats* sitesOut,
+                          int maxSites);
+
 
 /**
  * The underlying memory provider function which backs the allocator.
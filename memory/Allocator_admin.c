@@ -15,6 +15,8 @@
 #include "admin/Admin.h"
 #include "benc/String.h"
 #include "benc/Dict.h"
+#include "benc/List.h"
+#include "benc/Int.h"
 #include "memory/Allocator.h"
 #include "memory/Allocator_admin.h"
 #include "util/Identity.h"
@@ -43,6 +45,48 @@ static void bytesAllocated(Dict* in, void* vcontext, String* txid, struct Alloca
     Admin_sendMessage(d, txid, ctx->admin);
 }
 
+#define PROFILE_MAX_SITES 512
+#define PROFILE_PAGE 32
+static void siteProfile(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
+{
+    struct Allocator_admin_pvt* ctx = Identity_check((struct Allocator_admin_pvt*)vcontext);
+    int64_t* pageP = Dict_getIntC(args, "page");
+    int page = (pageP) ? (int) *pageP : 0;
+
+    struct Allocator_SiteStats* sites =
+        Allocator_calloc(requestAlloc, sizeof(struct Allocator_SiteStats), PROFILE_MAX_SITES);
+    int num = Allocator_siteProfile(ctx->alloc, sites, PROFILE_MAX_SITES);
+
+    // order by bytes, fattest sites first
+    for (int i = 0; i < num; i++) {
+        int biggest = i;
+        for (int j = i + 1; j < num; j++) {
+            if (sites[j].bytes > sites[biggest].bytes) { biggest = j; }
+        }
+        struct Allocator_SiteStats tmp = sites[i];
+        sites[i] = sites[biggest];
+        sites[biggest] = tmp;
+    }
+
+    List* list = List_new(requestAlloc);
+    for (int i = page * PROFILE_PAGE; i < num && i < (page + 1) * PROFILE_PAGE; i++) {
+        Dict* d = Dict_new(requestAlloc);
+        Dict_putStringCC(d, "file", (char*)sites[i].fileName, requestAlloc);
+        Dict_putIntC(d, "line", sites[i].lineNum, requestAlloc);
+        Dict_putIntC(d, "allocations", sites[i].allocations, requestAlloc);
+        Dict_putIntC(d, "bytes", sites[i].bytes, requestAlloc);
+        List_addDict(list, d, requestAlloc);
+    }
+
+    Dict* out = Dict_new(requestAlloc);
+    Dict_putListC(out, "sites", list, requestAlloc);
+    Dict_putIntC(out, "total", num, requestAlloc);
+    if (num > (page + 1) * PROFILE_PAGE) {
+        Dict_putIntC(out, "more", 1, requestAlloc);
+    }
+    Admin_sendMessage(out, txid, ctx->admin);
+}
+
 void Allocator_admin_register(struct Allocator* alloc, struct Admin* admin)
 {
     struct Allocator_admin_pvt* ctx = Allocator_clone(alloc, (&(struct Allocator_admin_pvt) {
@@ -55,4 +99,9 @@ void Allocator_admin_register(struct Allocator* alloc, struct Admin* admin)
             { .name = "includeAllocations", .required = 0, .type = "Int" }
         }), admin);
     Admin_registerFunction("Allocator_bytesAllocated", bytesAllocated, ctx, true, NULL, admin);
+
+    Admin_registerFunction("Allocator_siteProfile", siteProfile, ctx, true,
+        ((struct Admin_FunctionArg[]) {
+            { .name = "page", .required = 0, .type = "Int" }
+        }), admin);
 }
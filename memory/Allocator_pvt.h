@@ -44,6 +44,7 @@ struct Allocator_Allocation_pvt;
     Allocator_Allocation_SIZE + \
     __SIZEOF_POINTER__ + \
     __SIZEOF_POINTER__ + \
+    __SIZEOF_POINTER__ + \
     __SIZEOF_POINTER__ \
 )
 struct Allocator_Allocation_pvt {
@@ -57,6 +58,13 @@ struct Allocator_Allocation_pvt {
     #endif
     uintptr_t lineNum;
     const char* fileName;
+
+    /**
+     * Nonzero if the underlying provider block is the full size class for
+     * pub.size (pub.size itself stays exact so byte accounting is honest);
+     * cleared when a provider realloc makes the block exactly pub.size.
+     */
+    uintptr_t isClassBlock;
 };
 Assert_compileTime(sizeof(struct Allocator_Allocation_pvt) == Allocator_Allocation_pvt_SIZE);
 Assert_compileTime(!(Allocator_Allocation_pvt_SIZE % __BIGGEST_ALIGNMENT__));
@@ -128,6 +136,9 @@ struct Allocator_pvt
     Identity
 };
 
+/** Number of size classes of released allocations cached for reuse. */
+#define Allocator_FREE_CLASS_COUNT 5
+
 /** The first ("genesis") allocator, not a child of any other allocator. */
 struct Allocator_FirstCtx
 {
@@ -144,6 +155,30 @@ struct Allocator_FirstCtx
     /** The number of bytes which can be allocated total. */
     int64_t maxSpace;
 
+    /**
+     * Size-classed freelists of released allocations, class c holds blocks of
+     * exactly (1024 << c) bytes. Packet- and request-sized allocations churn
+     * hard; recycling them within the tree skips the provider round trip.
+     * Drained when the root is freed.
+     */
+    struct Allocator_Allocation_pvt* freeClasses[Allocator_FREE_CLASS_COUNT];
+    int freeClassCounts[Allocator_FREE_CLASS_COUNT];
+
+    /**
+     * Freelist of released blocks of exactly the allocator-struct size.
+     * Per-packet and per-request work creates and frees a child allocator
+     * each time; recycling the block makes that arena churn a pop/push.
+     * The block size is unchanged so the byte accounting is untouched.
+     */
+    struct Allocator_Allocation_pvt* allocatorStructFree;
+    int allocatorStructFreeCount;
+
+    /** Memory pressure notification, see Allocator_onMemoryPressure(). */
+    Allocator_OnPressureCallback pressureCb;
+    void* pressureCtx;
+    int64_t pressureThreshold;
+    int pressureFired;
+
     Identity
 };
 
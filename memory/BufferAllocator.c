@@ -20,6 +20,7 @@ struct BufferAllocator_pvt;
 #include "util/Identity.h"
 
 #include <stdint.h>
+#include <stdlib.h>
 
 /**
  * TODO(cjd): addOnFreeJob adds a job which is only run when the root allocator is freed
@@ -58,6 +59,12 @@ struct BufferAllocator_pvt
     ((char*) ((uintptr_t)( ((char*)(pointer)) + (alignedOn) - 1) & ~ ((alignedOn) - 1)))
 
 /** @see Allocator_malloc() */
+/** True if the pointer lives inside the fixed buffer (not an overflow block). */
+static int isInBuffer(struct BufferAllocator_pvt* context, void* pointer)
+{
+    return ((char*)pointer) >= context->basePointer && ((char*)pointer) < context->endPointer;
+}
+
 static void* allocatorMalloc(struct BufferAllocator_pvt* context, unsigned long length)
 {
     Identity_check(context);
@@ -65,7 +72,13 @@ static void* allocatorMalloc(struct BufferAllocator_pvt* context, unsigned long
     char* endOfAlloc = pointer + length;
 
     if (endOfAlloc >= context->endPointer) {
-        Except_throw(context->onOOM, "BufferAllocator ran out of memory.");
+        // Buffer exhausted: chain the allocation onto the heap instead of
+        // dying, it is released when the allocator lets go of it.
+        void* overflow = malloc(length);
+        if (!overflow) {
+            Except_throw(context->onOOM, "BufferAllocator ran out of memory.");
+        }
+        return overflow;
     }
 
     if (endOfAlloc < context->pointer) {
@@ -85,6 +98,19 @@ static void* provideMemory(struct BufferAllocator_pvt* context,
         return allocatorMalloc(context, size);
     }
 
+    if (!isInBuffer(context, original)) {
+        // overflow block, it lives on the heap
+        if (size == 0) {
+            free(original);
+            return NULL;
+        }
+        void* out = realloc(original, size);
+        if (!out) {
+            Except_throw(context->onOOM, "BufferAllocator ran out of memory.");
+        }
+        return out;
+    }
+
     if (((char*)original) + original->size == context->pointer) {
         // This is reallocating the last allocation.
         // clear the allocation then let allocatorMalloc() recreate it.
@@ -97,7 +123,8 @@ static void* provideMemory(struct BufferAllocator_pvt* context,
 
     void* newAlloc = allocatorMalloc(context, size);
     if (newAlloc != original) {
-        Assert_true((char*)newAlloc > (char*)original + original->size);
+        Assert_true(!isInBuffer(context, newAlloc)
+            || (char*)newAlloc > (char*)original + original->size);
         Bits_memcpy(newAlloc, original, original->size);
     }
     return newAlloc;
@@ -0,0 +1,132 @@
+/* vim: set expandtab ts=4 sw=4: */
+/*
+ * You may redistribute this program and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "memory/GuardPageAllocator.h"
+#include "util/Bits.h"
+
+#include <stdlib.h>
+
+#ifndef win32
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*
+ * Every allocation gets its own mapping with an inaccessible page directly
+ * behind it and the payload pushed up against that page, so any overrun
+ * faults on the spot instead of corrupting a neighbor. This burns at least
+ * two pages per allocation: strictly a debugging tool.
+ *
+ * Layout:  [ size header | ... padding ... |     payload     ][ guard page ]
+ * The returned pointer is (mapping + mappingSize - guardPage - payloadSize),
+ * the mapping size is stored at the very start of the mapping.
+ */
+
+struct GuardPageAllocator_Header
+{
+    unsigned long mappingSize;
+    unsigned long payloadSize;
+};
+
+static unsigned long pageSize(void)
+{
+    static unsigned long ps = 0;
+    if (!ps) { ps = (unsigned long) sysconf(_SC_PAGESIZE); }
+    return ps;
+}
+
+static void* guardAlloc(unsigned long size)
+{
+    const unsigned long ps = pageSize();
+    // payload pages + one page for the header slack + the guard page
+    unsigned long payloadPages = (size + ps - 1) / ps;
+    unsigned long mappingSize = (payloadPages + 2) * ps;
+
+    uint8_t* mapping = mmap(NULL, mappingSize, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) { return NULL; }
+    if (mprotect(&mapping[mappingSize - ps], ps, PROT_NONE)) {
+        munmap(mapping, mappingSize);
+        return NULL;
+    }
+
+    struct GuardPageAllocator_Header* hdr = (struct GuardPageAllocator_Header*) mapping;
+    hdr->mappingSize = mappingSize;
+    hdr->payloadSize = size;
+
+    // butt the payload up against the guard page, 8 byte aligned, and stash
+    // the offset back to the mapping start in the 8 bytes before the payload
+    // (there is always at least a page of slack between header and payload).
+    unsigned long offset = (mappingSize - ps - size) & ~7ul;
+    uint8_t* payload = &mapping[offset];
+    ((unsigned long*) payload)[-1] = offset;
+    return payload;
+}
+
+static void* provideMemory(void* vNULL,
+                           struct Allocator_Allocation* original,
+                           unsigned long size,
+                           struct Allocator* group)
+{
+    if (original == NULL) {
+        return (size) ? guardAlloc(size) : NULL;
+    }
+
+    unsigned long offset = ((unsigned long*) (void*) original)[-1];
+    uint8_t* mapping = ((uint8_t*) original) - offset;
+    struct GuardPageAllocator_Header* hdr = (struct GuardPageAllocator_Header*) mapping;
+
+    if (size == 0) {
+        munmap(mapping, hdr->mappingSize);
+        return NULL;
+    }
+
+    void* out = guardAlloc(size);
+    if (out) {
+        unsigned long copy = (hdr->payloadSize < size) ? hdr->payloadSize : size;
+        Bits_memcpy(out, original, copy);
+    }
+    munmap(mapping, hdr->mappingSize);
+    return out;
+}
+
+struct Allocator* GuardPageAllocator__new(const char* file, int line)
+{
+    return Allocator_new(0, provideMemory, NULL, file, line);
+}
+
+#else // win32
+
+// No guard page support, behave like the malloc allocator.
+static void* provideMemory(void* vNULL,
+                           struct Allocator_Allocation* original,
+                           unsigned long size,
+                           struct Allocator* group)
+{
+    if (original == NULL) {
+        return (size) ? malloc(size) : NULL;
+    }
+    if (size == 0) {
+        free(original);
+        return NULL;
+    }
+    return realloc(original, size);
+}
+
+struct Allocator* GuardPageAllocator__new(const char* file, int line)
+{
+    return Allocator_new(0, provideMemory, NULL, file, line);
+}
+
+#endif
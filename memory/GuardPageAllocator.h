@@ -0,0 +1,32 @@
+/* vim: set expandtab ts=4 sw=4: */
+/*
+ * You may redistribute this program and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef GuardPageAllocator_H
+#define GuardPageAllocator_H
+
+#include "memory/Allocator.h"
+#include "util/Linker.h"
+Linker_require("memory/GuardPageAllocator.c")
+
+/**
+ * A debugging allocator which maps every allocation with an inaccessible page
+ * directly behind it, so any buffer overrun faults at the exact instruction.
+ * Burns at least two pages per allocation; swap it in for a MallocAllocator
+ * when hunting memory corruption. Where mmap is unavailable (win32) it
+ * degrades to plain malloc.
+ */
+struct Allocator* GuardPageAllocator__new(const char* file, int line);
+#define GuardPageAllocator_new() GuardPageAllocator__new(Gcc_SHORT_FILE, Gcc_LINE)
+
+#endif
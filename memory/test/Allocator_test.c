@@ -76,9 +76,24 @@ static void structureSizes()
     Allocator_free(alloc);
 }
 
+static void allocationCount()
+{
+    struct Allocator* alloc = MallocAllocator_new(4096);
+    unsigned long base = Allocator_allocationCount(alloc);
+    Allocator_malloc(alloc, 25);
+    Assert_true(Allocator_allocationCount(alloc) == base + 1);
+    struct Allocator* child = Allocator_child(alloc);
+    Allocator_malloc(child, 30);
+    Assert_true(Allocator_allocationCount(alloc) == base + 3);
+    Allocator_free(child);
+    Assert_true(Allocator_allocationCount(alloc) == base + 1);
+    Allocator_free(alloc);
+}
+
 int main()
 {
     allocatorClone();
+    allocationCount();
     structureSizes();
     return 0;
 }
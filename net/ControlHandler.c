@@ -259,7 +259,12 @@ static Iface_DEFUN incomingFromCore(struct Message* msg, struct Iface* coreIf)
     Er_assert(Message_epop(msg, &routeHdr, RouteHeader_SIZE));
     uint8_t labelStr[20];
     uint64_t label = Endian_bigEndianToHost64(routeHdr.sh.label_be);
-    AddrTools_printPath(labelStr, label);
+    if (Defined(Log_INFO)) {
+        // only consumed by logging, don't print the path on the fast path otherwise
+        AddrTools_printPath(labelStr, label);
+    } else {
+        labelStr[0] = '\0';
+    }
     // happens in benchmark
     // Log_debug(ch->log, "ctrl packet from [%s]", labelStr);
 
@@ -277,10 +282,8 @@ static Iface_DEFUN incomingFromCore(struct Message* msg, struct Iface* coreIf)
 
     struct Control* ctrl = (struct Control*) msg->msgbytes;
 
-    if (ctrl->header.type_be == Control_ERROR_be) {
-        return handleError(msg, ch, label, labelStr, &routeHdr);
-
-    } else if (ctrl->header.type_be == Control_KEYPING_be
+    // pings and pongs first, they are the bulk of control traffic
+    if (ctrl->header.type_be == Control_KEYPING_be
             || ctrl->header.type_be == Control_PING_be)
     {
         return handlePing(msg, ch, label, labelStr, ctrl->header.type_be);
@@ -292,6 +295,9 @@ static Iface_DEFUN incomingFromCore(struct Message* msg, struct Iface* coreIf)
         Er_assert(Message_epush(msg, &routeHdr, RouteHeader_SIZE));
         return Iface_next(&ch->pub.switchPingerIf, msg);
 
+    } else if (ctrl->header.type_be == Control_ERROR_be) {
+        return handleError(msg, ch, label, labelStr, &routeHdr);
+
     } else if (ctrl->header.type_be == Control_GETSNODE_QUERY_be) {
         return handleGetSnodeQuery(msg, ch, label, labelStr);
 
@@ -52,6 +52,10 @@ struct Pathfinder
      */
     uint32_t bytesSinceLastPing;
 
+    /** Benchmarking counters for comparing concurrently-running pathfinders. */
+    uint64_t eventsIn;
+    uint64_t nodesIn;
+
     Identity
 };
 #define ArrayList_TYPE struct Pathfinder
@@ -186,12 +190,25 @@ static Iface_DEFUN incomingFromCore(struct Message* msg, struct Iface* trickIf)
         Assert_true(pf && pf->state == Pathfinder_state_CONNECTED);
         return sendToPathfinder(msg, pf);
     } else {
+        // the last subscriber gets the original message, only the others pay
+        // for a clone
+        struct Pathfinder* lastPf = NULL;
+        for (int i = ee->pathfinders->length - 1; i >= 0; i--) {
+            struct Pathfinder* pf = ArrayList_Pathfinders_get(ee->pathfinders, i);
+            if (pf && pf->state == Pathfinder_state_CONNECTED) {
+                lastPf = pf;
+                break;
+            }
+        }
         for (int i = 0; i < ee->pathfinders->length; i++) {
             struct Pathfinder* pf = ArrayList_Pathfinders_get(ee->pathfinders, i);
-            if (!pf || pf->state != Pathfinder_state_CONNECTED) { continue; }
+            if (!pf || pf->state != Pathfinder_state_CONNECTED || pf == lastPf) { continue; }
             struct Message* messageClone = Message_clone(msg, Message_getAlloc(msg));
             Iface_CALL(sendToPathfinder, messageClone, pf);
         }
+        if (lastPf) {
+            return sendToPathfinder(msg, lastPf);
+        }
     }
     return NULL;
 }
@@ -298,6 +315,9 @@ static Iface_DEFUN incomingFromPathfinder(struct Message* msg, struct Iface* ifa
         return Error(msg, "INVALID");
     }
 
+    pf->eventsIn++;
+    if (ev == PFChan_Pathfinder_NODE) { pf->nodesIn++; }
+
     if (pf->state == Pathfinder_state_DISCONNECTED) {
         if (ev != PFChan_Pathfinder_CONNECT) {
             Log_debug(ee->log, "DROPPF disconnected and event != CONNECT event:[%d]", ev);
@@ -372,3 +392,20 @@ struct EventEmitter* EventEmitter_new(struct Allocator* allocator,
     Identity_set(ee);
     return &ee->pub;
 }
+
+int EventEmitter_getPathfinderStats(struct EventEmitter* eventEmitter,
+                                    int num,
+                                    struct EventEmitter_PathfinderStats* statsOut)
+{
+    struct EventEmitter_pvt* ee = Identity_check((struct EventEmitter_pvt*) eventEmitter);
+    if (num < 0 || num >= ee->pathfinders->length) { return -1; }
+    struct Pathfinder* pf = ArrayList_Pathfinders_get(ee->pathfinders, num);
+    if (!pf) { return 0; }
+    statsOut->pathfinderId = pf->pathfinderId;
+    statsOut->superiority = pf->superiority;
+    statsOut->state = pf->state;
+    statsOut->eventsIn = pf->eventsIn;
+    statsOut->nodesIn = pf->nodesIn;
+    Bits_memcpy(statsOut->userAgent, pf->userAgent, 64);
+    return 1;
+}
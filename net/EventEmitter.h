@@ -40,4 +40,23 @@ void EventEmitter_regPathfinderIface(struct EventEmitter* ee, struct Iface* ifac
 
 struct EventEmitter* EventEmitter_new(struct Allocator* alloc, struct Log* log, uint8_t* publicKey);
 
+/** Per-pathfinder counters for comparing pathfinders running side by side. */
+struct EventEmitter_PathfinderStats
+{
+    uint32_t pathfinderId;
+    uint32_t superiority;
+    uint32_t state;
+    uint64_t eventsIn;
+    uint64_t nodesIn;
+    uint8_t userAgent[64];
+};
+
+/**
+ * Read stats for pathfinder number num.
+ * @return 1 if statsOut was filled, 0 if the slot is empty, -1 if out of range.
+ */
+int EventEmitter_getPathfinderStats(struct EventEmitter* ee,
+                                    int num,
+                                    struct EventEmitter_PathfinderStats* statsOut);
+
 #endif
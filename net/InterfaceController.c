@@ -105,19 +105,38 @@ struct InterfaceController_Iface_pvt
 
 struct Peer
 {
-    /** The interface which is registered with the switch. */
+    /** The interface which is registered with the switch, must be first, it is cast to Peer. */
     struct Iface switchIf;
 
     struct Iface plaintext;
     struct Iface ciphertext;
 
-    struct Allocator* alloc;
+    // ---- hot: touched for every packet to or from this peer ----
 
     Ca_Session_t* caSession;
 
+    /**
+     * If InterfaceController_PeerState_UNAUTHENTICATED, no permanent state will be kept.
+     * During transition from HANDSHAKE to ESTABLISHED, a check is done for a registeration of a
+     * node which is already registered in a different switch slot, if there is one and the
+     * handshake completes, it will be moved.
+     */
+    enum InterfaceController_PeerState state;
+
+    /** Milliseconds since the epoch when the last *valid* message was received. */
+    uint64_t timeOfLastMessage;
+
+    // traffic counters
+    uint64_t bytesOut;
+    uint64_t bytesIn;
+
     struct Kbps sendBw;
     struct Kbps recvBw;
 
+    // ---- cold: identity, bookkeeping and periodic-job state ----
+
+    struct Allocator* alloc;
+
     /** The interface which this peer belongs to. */
     struct InterfaceController_Iface_pvt* ici;
 
@@ -126,29 +145,28 @@ struct Peer
 
     struct Address addr;
 
-    /** Milliseconds since the epoch when the last *valid* message was received. */
-    uint64_t timeOfLastMessage;
-
     /** Time when the last switch ping response was received from this node. */
     uint64_t timeOfLastPing;
 
+    /** Egress limit for this peer in kilobits per second, zero means unshaped. */
+    uint32_t maxSendKbps;
+
     /** A counter to allow for 3/4 of all pings to be skipped when a node is definitely down. */
     uint32_t pingCount;
 
+    /**
+     * Current keepalive spacing for this peer, doubled after each good pong on
+     * a stable link and reset (0 means pingAfterMilliseconds) when the link
+     * wobbles, so long-stable peers are pinged far less often.
+     */
+    uint32_t pingSpacing;
+
     /** The handle which can be used to look up this endpoint in the endpoint set. */
     uint32_t handle;
 
     /** True if we should forget about the peer if they do not respond. */
     bool isIncomingConnection;
 
-    /**
-     * If InterfaceController_PeerState_UNAUTHENTICATED, no permanent state will be kept.
-     * During transition from HANDSHAKE to ESTABLISHED, a check is done for a registeration of a
-     * node which is already registered in a different switch slot, if there is one and the
-     * handshake completes, it will be moved.
-     */
-    enum InterfaceController_PeerState state;
-
     /**
      * The number of lost packets last time we checked.
      * _lastDrops and _lastPackets are the direct readings off of the ReplayProtector
@@ -160,10 +178,6 @@ struct Peer
     uint64_t lastDrops;
     uint64_t lastPackets;
 
-    // traffic counters
-    uint64_t bytesOut;
-    uint64_t bytesIn;
-
     Identity
 };
 
@@ -306,6 +320,15 @@ static void onPingResponse(struct SwitchPinger_Response* resp, void* onResponseC
 
     if (ep->state == InterfaceController_PeerState_ESTABLISHED) {
         sendPeer(0xffffffff, PFChan_Core_PEER, ep, resp->milliseconds);
+
+        // Stable link answered again: back the keepalive off, up to half of the
+        // unresponsive threshold so a dead link is still noticed in time.
+        uint32_t spacing = (ep->pingSpacing) ? ep->pingSpacing : ic->pingAfterMilliseconds;
+        spacing *= 2;
+        if (spacing > ic->unresponsiveAfterMilliseconds / 2) {
+            spacing = ic->unresponsiveAfterMilliseconds / 2;
+        }
+        ep->pingSpacing = spacing;
     }
 
     ep->timeOfLastPing = Time_currentTimeMilliseconds();
@@ -443,7 +466,8 @@ static void iciPing(struct InterfaceController_Iface_pvt* ici, struct InterfaceC
 
             continue;
         }
-        if (now < ep->timeOfLastPing + ic->pingAfterMilliseconds) {
+        uint32_t pingSpacing = (ep->pingSpacing) ? ep->pingSpacing : ic->pingAfterMilliseconds;
+        if (now < ep->timeOfLastPing + pingSpacing) {
             // Possibly an out-of-date node which is mangling packets, don't ping too often
             // because it causes the RumorMill to be filled with this node over and over.
             continue;
@@ -470,6 +494,8 @@ static void iciPing(struct InterfaceController_Iface_pvt* ici, struct InterfaceC
 
             sendPeer(0xffffffff, PFChan_Core_PEER_GONE, ep, 0xffff);
             ep->state = InterfaceController_PeerState_UNRESPONSIVE;
+            // back to the aggressive cadence until the link proves itself again
+            ep->pingSpacing = 0;
         }
 
         Log_debug(ic->logger,
@@ -532,9 +558,17 @@ static Iface_DEFUN sendFromSwitch(struct Message* msg, struct Iface* switchIf)
         return Error(msg, "UNHANDLED");
     }
 
+    uint32_t now = Time_currentTimeMilliseconds();
+    if (ep->maxSendKbps
+        && Kbps_accumulate(&ep->sendBw, now, Kbps_accumulate_NO_PACKET) >= ep->maxSendKbps)
+    {
+        // over the configured egress budget for this peer
+        return Error(msg, "FLOOD");
+    }
+
     ep->bytesOut += Message_getLength(msg);
 
-    Kbps_accumulate(&ep->sendBw, Time_currentTimeMilliseconds(), Message_getLength(msg));
+    Kbps_accumulate(&ep->sendBw, now, Message_getLength(msg));
 
     return Iface_next(&ep->plaintext, msg); // --> afterEncrypt
 }
@@ -1140,6 +1174,27 @@ void InterfaceController_resetPeering(struct InterfaceController* ifController,
     }
 }
 
+int InterfaceController_limitPeer(struct InterfaceController* ifController,
+                                  uint8_t herPublicKey[32],
+                                  uint32_t maxSendKbps)
+{
+    struct InterfaceController_pvt* ic =
+        Identity_check((struct InterfaceController_pvt*) ifController);
+
+    int count = 0;
+    for (int j = 0; j < ic->icis->length; j++) {
+        struct InterfaceController_Iface_pvt* ici = ArrayList_OfIfaces_get(ic->icis, j);
+        for (int i = 0; i < (int)ici->peerMap.count; i++) {
+            struct Peer* peer = ici->peerMap.values[i];
+            if (!Bits_memcmp(herPublicKey, peer->addr.key, 32)) {
+                peer->maxSendKbps = maxSendKbps;
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
 int InterfaceController_disconnectPeer(struct InterfaceController* ifController,
                                        uint8_t herPublicKey[32])
 {
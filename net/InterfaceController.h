@@ -219,6 +219,16 @@ void InterfaceController_resetPeering(struct InterfaceController* ifController,
  */
 int InterfaceController_disconnectPeer(struct InterfaceController* ifc, uint8_t herPublicKey[32]);
 
+/**
+ * Set an egress bandwidth limit for a peer; packets beyond the budget are
+ * dropped before encryption. Zero removes the limit.
+ *
+ * @return the number of peers which matched the key.
+ */
+int InterfaceController_limitPeer(struct InterfaceController* ifc,
+                                  uint8_t herPublicKey[32],
+                                  uint32_t maxSendKbps);
+
 /**
  * Get stats for the connected peers.
  *
@@ -171,6 +171,40 @@ static void adminDisconnectPeer(Dict* args,
     Admin_sendMessage(response, txid, context->admin);
 }
 
+static void adminLimitPeer(Dict* args,
+                           void* vcontext,
+                           String* txid,
+                           struct Allocator* requestAlloc)
+{
+    struct Context* context = Identity_check((struct Context*)vcontext);
+    String* pubkeyString = Dict_getStringC(args, "pubkey");
+    int64_t* kbpsP = Dict_getIntC(args, "maxSendKbps");
+    uint32_t maxSendKbps = (kbpsP && *kbpsP > 0) ? (uint32_t) *kbpsP : 0;
+
+    uint8_t pubkey[32];
+    uint8_t addr[16];
+    int count = 0;
+
+    char* errorMsg = NULL;
+    if (Key_parse(pubkeyString, pubkey, addr)) {
+        errorMsg = "bad key";
+    } else {
+        count = InterfaceController_limitPeer(context->ic, pubkey, maxSendKbps);
+        if (count == 0) {
+            errorMsg = "no peer found for that key";
+        }
+    }
+
+    Dict* response = Dict_new(requestAlloc);
+    Dict_putIntC(response, "success", errorMsg ? 0 : 1, requestAlloc);
+    if (errorMsg) {
+        Dict_putStringCC(response, "error", errorMsg, requestAlloc);
+    }
+    Dict_putIntC(response, "peersLimited", count, requestAlloc);
+
+    Admin_sendMessage(response, txid, context->admin);
+}
+
 static void adminResetPeering(Dict* args,
                               void* vcontext,
                               String* txid,
@@ -265,6 +299,12 @@ void InterfaceController_admin_register(struct InterfaceController* ic,
             { .name = "pubkey", .required = 0, .type = "String" }
         }), admin);
 
+    Admin_registerFunction("InterfaceController_limitPeer", adminLimitPeer, ctx, true,
+        ((struct Admin_FunctionArg[]) {
+            { .name = "pubkey", .required = 1, .type = "String" },
+            { .name = "maxSendKbps", .required = 0, .type = "Int" }
+        }), admin);
+
     Admin_registerFunction("InterfaceController_disconnectPeer", adminDisconnectPeer, ctx, true,
         ((struct Admin_FunctionArg[]) {
             { .name = "pubkey", .required = 1, .type = "String" }
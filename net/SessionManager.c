@@ -24,6 +24,7 @@
 #include "util/events/Timeout.h"
 #include "util/Checksum.h"
 #include "wire/Metric.h"
+#include "wire/Headers.h"
 
 /** Handle numbers 0-3 are reserved for CryptoAuth nonces. */
 #define MIN_FIRST_HANDLE 4
@@ -35,8 +36,14 @@ struct BufferedMessage
     struct Message* msg;
     struct Allocator* alloc;
     uint64_t timeSentMilliseconds;
+
+    /** Next message queued for the same destination, in arrival order. */
+    struct BufferedMessage* next;
 };
 
+/** Most messages which will be held for any single destination awaiting a search. */
+#define MAX_BUFFERED_PER_DEST 8
+
 struct Ip6 {
     uint8_t bytes[16];
 };
@@ -63,6 +70,23 @@ struct SessionManager_pvt
     struct EventBase* eventBase;
     uint32_t firstHandle;
     uint8_t ourPubKey[32];
+    uint8_t ourIp6[16];
+
+    /** Next map index for the incremental idle sweep, counts down and wraps. */
+    int sweepCursor;
+
+    /** Total number of buffered messages across all destinations (bufMap counts queues). */
+    int bufferedCount;
+
+    /**
+     * Direct-mapped handle -> map index hints, indexed by the low handle bits.
+     * A hint is verified against the map before use so it can never be wrong,
+     * only missing; the steady state per-packet lookup is one probe instead of
+     * a binary search.
+     */
+    #define HANDLE_HINTS 256
+    uint32_t handleHints[HANDLE_HINTS];
+
     Identity
 };
 
@@ -163,8 +187,17 @@ static inline void check(struct SessionManager_pvt* sm, int mapIndex)
 static inline struct SessionManager_Session_pvt* sessionForHandle(uint32_t handle,
                                                                   struct SessionManager_pvt* sm)
 {
-    int index = Map_OfSessionsByIp6_indexForHandle(handle - sm->firstHandle, &sm->ifaceMap);
-    if (index < 0) { return NULL; }
+    const uint32_t h = handle - sm->firstHandle;
+    const uint32_t slot = h % HANDLE_HINTS;
+    const uint32_t hint = sm->handleHints[slot];
+    int index;
+    if (hint < sm->ifaceMap.count && sm->ifaceMap.handles[hint] == h) {
+        index = hint;
+    } else {
+        index = Map_OfSessionsByIp6_indexForHandle(h, &sm->ifaceMap);
+        if (index < 0) { return NULL; }
+        sm->handleHints[slot] = index;
+    }
     check(sm, index);
     return Identity_check(sm->ifaceMap.values[index]);
 }
@@ -257,6 +290,17 @@ static void rerankPaths(struct SessionManager_Session_pvt* sess)
             bestI = i;
         }
     }
+    // A live pinned path overrides the metric order.
+    if (sess->pub.pinnedLabel) {
+        for (int i = 0; i < SessionManager_PATH_COUNT; i++) {
+            if (sess->pub.paths[i].label == sess->pub.pinnedLabel
+                && effectiveMetric(sess->sessionManager, &sess->pub.paths[i]) < Metric_DEAD_LINK)
+            {
+                bestI = i;
+                break;
+            }
+        }
+    }
     if (bestI != 0) {
         SessionManager_Path_t path0;
         Bits_memcpy(&path0, &sess->pub.paths[0], sizeof(path0));
@@ -466,6 +510,30 @@ static struct SessionManager_Session_pvt* getSession(struct SessionManager_pvt*
     return sess;
 }
 
+int SessionManager_pinPath(struct SessionManager* smPub, uint8_t ip6[16], uint64_t label)
+{
+    struct SessionManager_pvt* sm = Identity_check((struct SessionManager_pvt*) smPub);
+    struct SessionManager_Session_pvt* sess = sessionForIp6(ip6, sm);
+    if (!sess) { return -1; }
+    sess->pub.pinnedLabel = label;
+    rerankPaths(sess);
+    return 0;
+}
+
+int SessionManager_addPathHint(struct SessionManager* smPub,
+                               uint8_t pubKey[32],
+                               uint32_t version,
+                               uint64_t label)
+{
+    struct SessionManager_pvt* sm = Identity_check((struct SessionManager_pvt*) smPub);
+    if (!label) { return -1; }
+    uint8_t ip6[16];
+    AddressCalc_addressForPublicKey(ip6, pubKey);
+    if (!AddressCalc_validAddress(ip6)) { return -1; }
+    getSession(sm, ip6, pubKey, version, label, Metric_RESUME_HINT);
+    return 0;
+}
+
 static Iface_DEFUN ctrlFrame(struct Message* msg, struct SessionManager_pvt* sm)
 {
     struct RouteHeader rh;
@@ -559,15 +627,97 @@ static Iface_DEFUN incomingFromSwitchIf(struct Message* msg, struct Iface* iface
     return Iface_next(&session->ciphertext, msg);
 }
 
+/** How much of the original packet is quoted back in an unreachable message. */
+#define ICMP_QUOTE_MAX 520
+
+/**
+ * Tell the host why its flow went nowhere: when a buffered packet is dropped
+ * because the search came up empty, synthesize an ICMPv6 "no route to
+ * destination" back up through the TUN, quoting the reconstructed original
+ * packet. Without this, applications sit in their own timeouts.
+ */
+static void icmpUnreachable(struct SessionManager_pvt* sm, struct Message* orig)
+{
+    if (Message_getLength(orig) < RouteHeader_SIZE + DataHeader_SIZE) { return; }
+    struct RouteHeader* origRh = (struct RouteHeader*) orig->msgbytes;
+    struct DataHeader* origDh = (struct DataHeader*) &origRh[1];
+    enum ContentType type = DataHeader_getContentType(origDh);
+    if (type > ContentType_IP6_MAX || type == ContentType_IP6_ICMPV6) {
+        // never answer icmp with icmp
+        return;
+    }
+
+    const int payloadLen = Message_getLength(orig) - RouteHeader_SIZE - DataHeader_SIZE;
+    const int quoteLen = (payloadLen > ICMP_QUOTE_MAX) ? ICMP_QUOTE_MAX : payloadLen;
+
+    struct Allocator* alloc = Allocator_child(sm->alloc);
+    struct Message* msg = Message_new(
+        Headers_ICMP6Header_SIZE + Headers_IP6Header_SIZE + quoteLen, 512, alloc);
+
+    struct Headers_ICMP6Header* icmp = (struct Headers_ICMP6Header*) msg->msgbytes;
+    Bits_memset(icmp, 0, Headers_ICMP6Header_SIZE);
+    icmp->type = 1; // destination unreachable
+    icmp->code = 0; // no route to destination
+
+    // The quoted packet is the original IPv6 header as the TUN produced it,
+    // rebuilt the same way TUNAdapter rebuilds it, plus the leading payload.
+    struct Headers_IP6Header* ip6 =
+        (struct Headers_IP6Header*) &msg->msgbytes[Headers_ICMP6Header_SIZE];
+    Bits_memset(ip6, 0, Headers_IP6Header_SIZE);
+    Headers_setIpVersion(ip6);
+    ip6->payloadLength_be = Endian_hostToBigEndian16(payloadLen);
+    ip6->nextHeader = type;
+    ip6->hopLimit = 42;
+    Bits_memcpy(ip6->sourceAddr, sm->ourIp6, 16);
+    Bits_memcpy(ip6->destinationAddr, origRh->ip6, 16);
+    Bits_memcpy(&msg->msgbytes[Headers_ICMP6Header_SIZE + Headers_IP6Header_SIZE],
+                &orig->msgbytes[RouteHeader_SIZE + DataHeader_SIZE],
+                quoteLen);
+
+    // The outer packet which TUNAdapter will build carries the failed
+    // destination as its source address and us as the destination.
+    uint8_t srcAndDest[32];
+    Bits_memcpy(srcAndDest, origRh->ip6, 16);
+    Bits_memcpy(&srcAndDest[16], sm->ourIp6, 16);
+    icmp->checksum =
+        Checksum_icmp6_be(srcAndDest, msg->msgbytes, Message_getLength(msg));
+
+    Er_assert(Message_epush(msg, NULL, DataHeader_SIZE));
+    struct DataHeader* dh = (struct DataHeader*) msg->msgbytes;
+    DataHeader_setContentType(dh, ContentType_IP6_ICMPV6);
+    DataHeader_setVersion(dh, DataHeader_CURRENT_VERSION);
+
+    Er_assert(Message_epush(msg, NULL, RouteHeader_SIZE));
+    struct RouteHeader* rh = (struct RouteHeader*) msg->msgbytes;
+    Bits_memcpy(rh->ip6, origRh->ip6, 16);
+
+    Iface_send(&sm->pub.insideIf, msg);
+    Allocator_free(alloc);
+}
+
 static void checkTimedOutBuffers(struct SessionManager_pvt* sm)
 {
+    const int64_t now = Time_currentTimeMilliseconds();
+    int icmpBudget = 8;
     for (int i = 0; i < (int)sm->bufMap.count; i++) {
+        // Queues are in arrival order so the timed-out messages are a prefix.
         struct BufferedMessage* buffered = sm->bufMap.values[i];
-        int64_t lag = Time_currentTimeMilliseconds() - buffered->timeSentMilliseconds;
-        if (lag < 10000) { continue; }
-        Map_BufferedMessages_remove(i, &sm->bufMap);
-        Allocator_free(buffered->alloc);
-        i--;
+        while (buffered && now - buffered->timeSentMilliseconds >= 10000) {
+            struct BufferedMessage* next = buffered->next;
+            if (icmpBudget > 0) {
+                icmpBudget--;
+                icmpUnreachable(sm, buffered->msg);
+            }
+            Allocator_free(buffered->alloc);
+            sm->bufferedCount--;
+            buffered = next;
+        }
+        if (!buffered) {
+            Map_BufferedMessages_remove(i, &sm->bufMap);
+            i--;
+        } else {
+            sm->bufMap.values[i] = buffered;
+        }
     }
 }
 
@@ -621,9 +771,21 @@ static SessionManager_Path_t* mostRecentValidatedPath(struct SessionManager_Sess
 
 static void checkTimedOutSessions(struct SessionManager_pvt* sm)
 {
-    for (int i = (int)sm->ifaceMap.count - 1; i >= 0; i--) {
+    const int count = (int)sm->ifaceMap.count;
+    if (!count) { return; }
+    const int64_t now = Time_currentTimeMilliseconds();
+
+    // Sweep a bounded slice of the table per tick rather than the whole thing.
+    // The cursor wraps so every session is still visited well inside the
+    // timeout and search periods, but a tick's work no longer grows with the
+    // session count.
+    int budget = count / 8 + 1;
+    int i = sm->sweepCursor;
+    if (i >= count || i < 0) { i = count - 1; }
+
+    for (; i >= 0 && budget > 0; i--, budget--) {
+        if (i >= (int)sm->ifaceMap.count) { continue; }
         struct SessionManager_Session_pvt* sess = sm->ifaceMap.values[i];
-        int64_t now = Time_currentTimeMilliseconds();
 
         // Check if the session is timed out...
         SessionManager_Path_t* path = mostRecentValidatedPath(sess);
@@ -656,6 +818,7 @@ static void checkTimedOutSessions(struct SessionManager_pvt* sm)
             unsetupSession(sm, sess);
         }
     }
+    sm->sweepCursor = i;
 }
 
 static void periodically(void* vSessionManager)
@@ -678,22 +841,41 @@ static void bufferPacket(struct SessionManager_pvt* sm, struct Message* msg)
     AddrTools_printIp(ipStr, header->ip6);
 
     int index = Map_BufferedMessages_indexForKey((struct Ip6*)header->ip6, &sm->bufMap);
-    if (index > -1) {
-        struct BufferedMessage* buffered = sm->bufMap.values[index];
-        Map_BufferedMessages_remove(index, &sm->bufMap);
-        Allocator_free(buffered->alloc);
-        Log_debug(sm->log, "Buffering a packet to [%s] DROP replacing one in the buffer", ipStr);
+    struct BufferedMessage* head = (index > -1) ? sm->bufMap.values[index] : NULL;
+
+    int queueLen = 0;
+    struct BufferedMessage* tail = head;
+    for (struct BufferedMessage* bm = head; bm; bm = bm->next) {
+        tail = bm;
+        queueLen++;
+    }
+
+    if (queueLen >= MAX_BUFFERED_PER_DEST) {
+        // Full queue for this destination, drop the oldest to make room.
+        Log_debug(sm->log, "Buffering a packet to [%s] DROP oldest, queue full", ipStr);
+        struct BufferedMessage* old = head;
+        head = old->next;
+        sm->bufMap.values[index] = head;
+        Allocator_free(old->alloc);
+        sm->bufferedCount--;
     } else {
-        Log_debug(sm->log, "Buffering a packet to [%s]", ipStr);
+        Log_debug(sm->log, "Buffering a packet to [%s] ([%d] in queue)", ipStr, queueLen);
     }
-    if ((int)sm->bufMap.count >= sm->pub.maxBufferedMessages) {
+
+    if (sm->bufferedCount >= sm->pub.maxBufferedMessages) {
         checkTimedOutBuffers(sm);
-        if ((int)sm->bufMap.count >= sm->pub.maxBufferedMessages) {
+        if (sm->bufferedCount >= sm->pub.maxBufferedMessages) {
             Log_debug(sm->log, "DROP message needing lookup maxBufferedMessages ([%d]) is reached",
                       sm->pub.maxBufferedMessages);
             return;
         }
+        // checkTimedOutBuffers() may have dropped this queue, re-probe.
+        index = Map_BufferedMessages_indexForKey((struct Ip6*)header->ip6, &sm->bufMap);
+        head = (index > -1) ? sm->bufMap.values[index] : NULL;
+        tail = head;
+        while (tail && tail->next) { tail = tail->next; }
     }
+
     struct Allocator* lookupAlloc = Allocator_child(sm->alloc);
     struct BufferedMessage* buffered =
         Allocator_calloc(lookupAlloc, sizeof(struct BufferedMessage), 1);
@@ -701,7 +883,12 @@ static void bufferPacket(struct SessionManager_pvt* sm, struct Message* msg)
     buffered->alloc = lookupAlloc;
     buffered->timeSentMilliseconds = Time_currentTimeMilliseconds();
     Allocator_adopt(lookupAlloc, Message_getAlloc(msg));
-    Assert_true(Map_BufferedMessages_put((struct Ip6*)header->ip6, &buffered, &sm->bufMap) > -1);
+    sm->bufferedCount++;
+    if (tail) {
+        tail->next = buffered;
+    } else {
+        Assert_true(Map_BufferedMessages_put((struct Ip6*)header->ip6, &buffered, &sm->bufMap) > -1);
+    }
 }
 
 static void needsLookup(struct SessionManager_pvt* sm, struct Message* msg)
@@ -868,9 +1055,14 @@ static Iface_DEFUN incomingFromEventIf(struct Message* msg, struct Iface* iface)
     // Send what's on the buffer...
     if (index > -1 && Ca_getState(sess->pub.caSession) >= Ca_State_RECEIVED_KEY) {
         struct BufferedMessage* bm = sm->bufMap.values[index];
-        Iface_CALL(readyToSend, bm->msg, sm, sess);
         Map_BufferedMessages_remove(index, &sm->bufMap);
-        Allocator_free(bm->alloc);
+        while (bm) {
+            struct BufferedMessage* next = bm->next;
+            Iface_CALL(readyToSend, bm->msg, sm, sess);
+            sm->bufferedCount--;
+            Allocator_free(bm->alloc);
+            bm = next;
+        }
     }
     return NULL;
 }
@@ -898,6 +1090,7 @@ struct SessionManager* SessionManager_new(struct Allocator* allocator,
         SessionManager_SESSION_SEARCH_AFTER_MILLISECONDS_DEFAULT;
 
     Ca_getPubKey(cryptoAuth, sm->ourPubKey);
+    AddressCalc_addressForPublicKey(sm->ourIp6, sm->ourPubKey);
 
     sm->eventIf.send = incomingFromEventIf;
     EventEmitter_regCore(ee, &sm->eventIf, PFChan_Pathfinder_NODE);
@@ -103,6 +103,12 @@ struct SessionManager_Session
 
     /** The version of the other node. */
     uint32_t version;
+
+    /**
+     * If nonzero, path selection keeps this label in front as long as it is
+     * alive, see SessionManager_pinPath().
+     */
+    uint64_t pinnedLabel;
 };
 
 struct SessionManager_HandleList
@@ -126,6 +132,29 @@ struct SessionManager_Session* SessionManager_sessionForHandle(uint32_t handle,
 struct SessionManager_Session* SessionManager_sessionForIp6(uint8_t* lookupKey,
                                                             struct SessionManager* sm);
 
+/**
+ * Create or update a session from a path hint, e.g. one exported with the
+ * SessionManager_sessionHints RPC before a restart. The path is installed
+ * with Metric_RESUME_HINT so any live source of truth overrides it, but an
+ * outgoing packet can use it immediately instead of waiting out a search.
+ *
+ * @return 0 on success, -1 if the hint is unusable.
+ */
+int SessionManager_addPathHint(struct SessionManager* sm,
+                               uint8_t pubKey[32],
+                               uint32_t version,
+                               uint64_t label);
+
+/**
+ * Pin (label != 0) or unpin (label == 0) the path used for a destination.
+ * A pinned path wins ranking while it is known and not dead; if it dies or
+ * is forgotten, selection falls back to the normal metric order rather than
+ * blackholing the flow.
+ *
+ * @return 0 on success, -1 if there is no session for the address.
+ */
+int SessionManager_pinPath(struct SessionManager* sm, uint8_t ip6[16], uint64_t label);
+
 /**
  * Get the list of all handles.
  */
@@ -102,10 +102,92 @@ static void outputSession(struct Context* context,
     Dict_putIntC(r, "metric", SessionManager_effectiveMetric(session), alloc);
     Dict_putIntC(r, "timeOfLastUsage", session->timeOfLastUsage, alloc);
 
+    // flow accounting ledger
+    Dict_putIntC(r, "bytesIn", session->bytesIn, alloc);
+    Dict_putIntC(r, "bytesOut", session->bytesOut, alloc);
+
     Admin_sendMessage(r, txid, context->admin);
     return;
 }
 
+static void pinPath(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
+{
+    struct Context* context = Identity_check((struct Context*) vcontext);
+    String* ip6Str = Dict_getStringC(args, "ip6");
+    String* pathStr = Dict_getStringC(args, "path");
+    char* error = NULL;
+    uint8_t ip6[16];
+    uint64_t label = 0;
+    if (!ip6Str || ip6Str->len != 39 || AddrTools_parseIp(ip6, (uint8_t*) ip6Str->bytes)) {
+        error = "unparsable ip6";
+    } else if (pathStr && pathStr->len
+        && (pathStr->len != 19 || AddrTools_parsePath(&label, (uint8_t*) pathStr->bytes)))
+    {
+        error = "unparsable path";
+    } else if (SessionManager_pinPath(context->sm, ip6, label)) {
+        error = "no session for that address";
+    }
+    Dict* out = Dict_new(requestAlloc);
+    Dict_putStringCC(out, "error", (error) ? error : "none", requestAlloc);
+    Admin_sendMessage(out, txid, context->admin);
+}
+
+static void sessionHints(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
+{
+    struct Context* context = Identity_check((struct Context*) vcontext);
+    struct Allocator* alloc = Allocator_child(context->alloc);
+
+    int64_t* page = Dict_getIntC(args, "page");
+    int i = (page) ? *page * ENTRIES_PER_PAGE : 0;
+    struct SessionManager_HandleList* hList = SessionManager_getHandleList(context->sm, alloc);
+
+    List* list = List_new(alloc);
+    for (int counter = 0; i < hList->length && counter++ < ENTRIES_PER_PAGE; i++) {
+        struct SessionManager_Session* session =
+            SessionManager_sessionForHandle(hList->handles[i], context->sm);
+        if (!session || !session->paths[0].label) { continue; }
+        struct Address addr = {0};
+        Ca_getHerPubKey(session->caSession, addr.key);
+        if (Bits_isZero(addr.key, 32)) { continue; }
+        Address_getPrefix(&addr);
+        addr.path = session->paths[0].label;
+        addr.protocolVersion = session->version;
+        List_addString(list, Address_toStringKey(&addr, alloc), alloc);
+    }
+
+    Dict* r = Dict_new(alloc);
+    Dict_putListC(r, "hints", list, alloc);
+    if (i < hList->length) {
+        Dict_putIntC(r, "more", 1, alloc);
+    }
+    Admin_sendMessage(r, txid, context->admin);
+    Allocator_free(alloc);
+}
+
+static void importHints(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
+{
+    struct Context* context = Identity_check((struct Context*) vcontext);
+    List* hints = Dict_getListC(args, "hints");
+    int imported = 0;
+    int failed = 0;
+    const int numHints = List_size(hints);
+    for (int i = 0; i < numHints; i++) {
+        String* hint = List_getString(hints, i);
+        struct Address* addr = (hint) ? Address_fromString(hint, requestAlloc) : NULL;
+        if (!addr || SessionManager_addPathHint(
+            context->sm, addr->key, addr->protocolVersion, addr->path))
+        {
+            failed++;
+            continue;
+        }
+        imported++;
+    }
+    Dict* r = Dict_new(requestAlloc);
+    Dict_putIntC(r, "imported", imported, requestAlloc);
+    Dict_putIntC(r, "failed", failed, requestAlloc);
+    Admin_sendMessage(r, txid, context->admin);
+}
+
 static void sessionStats(Dict* args,
                          void* vcontext,
                          String* txid,
@@ -200,4 +282,20 @@ void SessionManager_admin_register(struct SessionManager* sm,
         ((struct Admin_FunctionArg[]) {
             { .name = "ip6", .required = 1, .type = "String" }
         }), admin);
+
+    Admin_registerFunction("SessionManager_sessionHints", sessionHints, ctx, true,
+        ((struct Admin_FunctionArg[]) {
+            { .name = "page", .required = 0, .type = "Int" }
+        }), admin);
+
+    Admin_registerFunction("SessionManager_importHints", importHints, ctx, true,
+        ((struct Admin_FunctionArg[]) {
+            { .name = "hints", .required = 1, .type = "List" }
+        }), admin);
+
+    Admin_registerFunction("SessionManager_pinPath", pinPath, ctx, true,
+        ((struct Admin_FunctionArg[]) {
+            { .name = "ip6", .required = 1, .type = "String" },
+            { .name = "path", .required = 0, .type = "String" }
+        }), admin);
 }
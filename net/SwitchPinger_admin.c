@@ -21,6 +21,7 @@
 #include "net/SwitchPinger_admin.h"
 #include "util/Endian.h"
 #include "util/AddrTools.h"
+#include "wire/Control.h"
 #include "crypto/Key.h"
 
 #define DEFAULT_TIMEOUT 2000
@@ -75,7 +76,23 @@ static void adminPing(Dict* args, void* vcontext, String* txid, struct Allocator
     int64_t* timeoutPtr = Dict_getIntC(args, "timeout");
     String* data = Dict_getStringC(args, "data");
     int64_t* keyPing = Dict_getIntC(args, "keyPing");
+    int64_t* sizePtr = Dict_getIntC(args, "size");
     uint32_t timeout = (timeoutPtr) ? *timeoutPtr : DEFAULT_TIMEOUT;
+
+    // For payload-size probing: pad the ping out to an exact payload size
+    // (a probe which only comes back at small sizes has found a limit).
+    // Overrides data. Clamped to what SwitchPinger_newPing() will accept,
+    // and for keypings to the cookie limit so the keypong isn't oversized.
+    if (sizePtr && *sizePtr > 0) {
+        int64_t max = (keyPing && *keyPing)
+            ? (Control_KeyPing_MAX_SIZE - Control_KeyPing_HEADER_SIZE)
+            : Control_Ping_MAX_SIZE;
+        uint32_t size = (*sizePtr > max) ? (uint32_t) max : (uint32_t) *sizePtr;
+        data = String_newBinary(NULL, size, requestAlloc);
+        for (uint32_t i = 0; i < size; i++) {
+            data->bytes[i] = 'a' + (i % 26);
+        }
+    }
     uint64_t path;
     String* err = NULL;
     if (pathStr->len != 19 || AddrTools_parsePath(&path, (uint8_t*) pathStr->bytes)) {
@@ -87,10 +104,10 @@ static void adminPing(Dict* args, void* vcontext, String* txid, struct Allocator
                                                               adminPingOnResponse,
                                                               context->alloc,
                                                               context->switchPinger);
-        if (keyPing && *keyPing) { ping->type = SwitchPinger_Type_KEYPING; }
         if (!ping) {
             err = String_CONST("no open slots to store ping, try later.");
         } else {
+            if (keyPing && *keyPing) { ping->type = SwitchPinger_Type_KEYPING; }
             ping->onResponseContext = Allocator_clone(ping->pingAlloc, (&(struct Ping) {
                 .context = context,
                 .txid = String_clone(txid, ping->pingAlloc),
@@ -121,6 +138,7 @@ void SwitchPinger_admin_register(struct SwitchPinger* sp,
             { .name = "path", .required = 1, .type = "String" },
             { .name = "timeout", .required = 0, .type = "Int" },
             { .name = "data", .required = 0, .type = "String" },
-            { .name = "keyPing", .required = 0, .type = "Int" }
+            { .name = "keyPing", .required = 0, .type = "Int" },
+            { .name = "size", .required = 0, .type = "Int" }
         }), admin);
 }
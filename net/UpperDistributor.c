@@ -46,6 +46,15 @@ struct UpperDistributor_pvt
 
     struct Map_OfHandlers* handlers;
 
+    /**
+     * Dispatch index over the handler list: a presence bitmap for the IP6
+     * content types and a count of handlers for the high types, so the
+     * per-packet case of "no handler registered for this type" is one test
+     * instead of a walk over the handler list.
+     */
+    uint64_t handlerTypeBitmap[4];
+    int highTypeHandlerCount;
+
     struct Allocator* alloc;
     int noSendToHandler;
     Identity
@@ -55,6 +64,20 @@ struct UpperDistributor_pvt
 
 static Iface_DEFUN incomingFromSessionManagerIf(struct Message*, struct Iface*);
 
+static void rebuildHandlerIndex(struct UpperDistributor_pvt* ud)
+{
+    Bits_memset(ud->handlerTypeBitmap, 0, sizeof(ud->handlerTypeBitmap));
+    ud->highTypeHandlerCount = 0;
+    for (int i = 0; i < (int)ud->handlers->count; i++) {
+        enum ContentType t = ud->handlers->values[i]->pub.type;
+        if (t < 256) {
+            ud->handlerTypeBitmap[t >> 6] |= (((uint64_t)1) << (t & 63));
+        } else {
+            ud->highTypeHandlerCount++;
+        }
+    }
+}
+
 static Iface_DEFUN fromHandler(struct Message* msg, struct UpperDistributor_pvt* ud)
 {
     Er_assert(Message_epop(msg, NULL, RouteHeader_SIZE));
@@ -123,6 +146,11 @@ static void sendToHandlers(struct Message* msg,
         ud->noSendToHandler--;
         return;
     }
+    if ((int)type < 256) {
+        if (!(ud->handlerTypeBitmap[type >> 6] & (((uint64_t)1) << (type & 63)))) { return; }
+    } else if (!ud->highTypeHandlerCount) {
+        return;
+    }
     for (int i = 0; i < (int)ud->handlers->count; i++) {
         if (ud->handlers->values[i]->pub.type != type) { continue; }
         struct Allocator* alloc = Allocator_child(Message_getAlloc(msg));
@@ -255,6 +283,7 @@ int UpperDistributor_unregisterHandler(struct UpperDistributor* upper, int udpPo
     struct UpperDistributor_Handler_pvt* udhp = ud->handlers->values[index];
     Map_OfHandlers_remove(index, ud->handlers);
     Allocator_free(udhp->alloc);
+    rebuildHandlerIndex(ud);
     return 0;
 }
 
@@ -294,6 +323,7 @@ int UpperDistributor_registerHandler(struct UpperDistributor* upper,
     udhp->pub.udpPort = udpPort;
     udhp->pub.type = ct;
     Assert_true(Map_OfHandlers_put(&udpPort, &udhp, ud->handlers) >= 0);
+    rebuildHandlerIndex(ud);
     return 0;
 }
 
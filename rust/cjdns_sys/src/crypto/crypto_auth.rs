@@ -41,6 +41,37 @@ pub struct CryptoAuth {
     event_base: EventBase,
     rand: Random,
     noise: Arc<crypto_noise::CryptoNoise>,
+
+    /// Limits how many handshakes (expensive public-key work) are processed
+    /// per unit time across all sessions, so a handshake flood degrades into
+    /// dropped hellos instead of a pegged core.
+    handshake_bucket: Mutex<HandshakeBucket>,
+}
+
+/// Handshakes allowed to burst before the flood limiter bites, refills 1/ms.
+const HANDSHAKE_BUCKET_SIZE: u32 = 256;
+
+#[derive(Default)]
+struct HandshakeBucket {
+    tokens: u32,
+    last: Option<std::time::Instant>,
+}
+
+impl HandshakeBucket {
+    fn overloaded(&mut self) -> bool {
+        let now = std::time::Instant::now();
+        let refill = match self.last {
+            Some(last) => (now - last).as_millis().min(HANDSHAKE_BUCKET_SIZE as u128) as u32,
+            None => HANDSHAKE_BUCKET_SIZE,
+        };
+        self.tokens = (self.tokens + refill).min(HANDSHAKE_BUCKET_SIZE);
+        self.last = Some(now);
+        if self.tokens == 0 {
+            return true;
+        }
+        self.tokens -= 1;
+        false
+    }
 }
 
 #[derive(Default, Clone)]
@@ -278,6 +309,7 @@ impl CryptoAuth {
             event_base,
             rand,
             noise,
+            handshake_bucket: Mutex::new(HandshakeBucket::default()),
         }
     }
 
@@ -887,6 +919,14 @@ impl SessionMut {
         mut header: CryptoHeader,
         sess: &SessionInner,
     ) -> Result<()> {
+        if sess.context.handshake_bucket.lock().overloaded() {
+            // A wireguard-style stateless cookie challenge would be the
+            // complete answer but needs a wire extension; dropping under
+            // flood keeps the loop alive and legitimate peers simply retry.
+            debug::log(self, || "DROP handshake, overloaded");
+            return Err(DecryptError::DecryptErr(DecryptErr::NoSession).into());
+        }
+
         if msg.len() < CryptoHeader::SIZE {
             debug::log(self, || "DROP runt");
             return Err(DecryptError::DecryptErr(DecryptErr::Runt).into());
@@ -1,9 +1,16 @@
 //! Replay attack protector
 
+/// Width of the anti-replay window in 64 bit words.
+const WINDOW_WORDS: usize = 4;
+/// Width of the anti-replay window in bits.
+const WINDOW: u32 = (WINDOW_WORDS as u32) * 64;
+/// Headroom kept below the top of the window when it must be force-shifted.
+const FORCE_SHIFT_HEADROOM: u32 = 17;
+
 #[derive(Default)]
 pub struct ReplayProtector {
-    /// Internal bitfield.
-    bitfield: u64,
+    /// Internal bitfield, word zero holds the lowest offsets.
+    bitfield: [u64; WINDOW_WORDS],
 
     /// Internal offset.
     base_offset: u32,
@@ -39,12 +46,13 @@ impl ReplayProtector {
 
     pub fn init(&mut self, first_nonce: u32) {
         self.base_offset = first_nonce;
-        self.bitfield = 0;
+        self.bitfield = [0; WINDOW_WORDS];
     }
 
     pub fn stats(&self) -> ReplayProtectorStats {
+        let set: u32 = self.bitfield.iter().map(|w| w.count_ones()).sum();
         ReplayProtectorStats {
-            received_packets: self.base_offset + self.bitfield.count_ones(),
+            received_packets: self.base_offset + set,
             lost_packets: self.lost_packets,
             received_unexpected: self.received_out_of_range,
             duplicate_packets: self.duplicates,
@@ -57,8 +65,8 @@ impl ReplayProtector {
     /// or else forged packets will make legit ones appear to be duplicates.
     ///
     /// Arg `nonce` is the number to check, this should be a counter nonce
-    /// as numbers less than 32 minus the highest seen nonce will be dropped
-    /// erroneously.
+    /// as numbers less than the window minus the highest seen nonce will be
+    /// dropped erroneously.
     ///
     /// Returns `true` if the packet is provably not a replay, otherwise `false`.
     pub fn check_nonce(&mut self, nonce: u32) -> bool {
@@ -68,49 +76,138 @@ impl ReplayProtector {
         }
 
         let mut offset = nonce - self.base_offset;
-        while offset > 63 {
-            if self.bitfield & 0xFFFF_FFFF == 0xFFFF_FFFF {
+        while offset > WINDOW - 1 {
+            if self.bitfield[0] & 0xFFFF_FFFF == 0xFFFF_FFFF {
                 // Happy path, low 32 bits are checked in, rotate and continue.
                 offset = self.do_shift(offset, 32);
             } else {
-                // We are going to have to accept some losses, take offset - 47 to mitigate that
-                // as much as possible.
-                debug_assert!(offset >= 47);
-                self.lost_packets += self.lost_in_shift(offset - 47);
-                offset = self.do_shift(offset, offset - 47);
+                // We are going to have to accept some losses, shift as little
+                // as possible (leave some headroom) to mitigate that.
+                let shift = offset - (WINDOW - FORCE_SHIFT_HEADROOM);
+                self.lost_packets += self.lost_in_shift(shift);
+                offset = self.do_shift(offset, shift);
             }
         }
 
-        let mask = 1_u64 << offset;
+        let word = (offset >> 6) as usize;
+        let mask = 1_u64 << (offset & 63);
 
-        if self.bitfield & mask != 0 {
+        if self.bitfield[word] & mask != 0 {
             self.duplicates += 1;
             return false;
         }
 
-        self.bitfield |= mask;
-        return true;
+        self.bitfield[word] |= mask;
+        true
     }
 
     #[inline]
     fn do_shift(&mut self, offset: u32, bits: u32) -> u32 {
         self.base_offset += bits;
-        if bits > 63 {
-            self.bitfield = 0;
+        if bits >= WINDOW {
+            self.bitfield = [0; WINDOW_WORDS];
         } else {
-            self.bitfield >>= bits;
+            let words = (bits >> 6) as usize;
+            let rem = bits & 63;
+            for w in 0..WINDOW_WORDS {
+                let mut out = if w + words < WINDOW_WORDS {
+                    self.bitfield[w + words]
+                } else {
+                    0
+                };
+                if rem != 0 {
+                    out >>= rem;
+                    if w + words + 1 < WINDOW_WORDS {
+                        out |= self.bitfield[w + words + 1] << (64 - rem);
+                    }
+                }
+                self.bitfield[w] = out;
+            }
         }
         offset - bits
     }
 
+    /// Count the set bits in the lowest `shift_amount` bits of the window.
+    #[inline]
+    fn pop_count_low(&self, shift_amount: u32) -> u32 {
+        let mut remaining = shift_amount;
+        let mut count = 0;
+        for w in 0..WINDOW_WORDS {
+            if remaining == 0 {
+                break;
+            }
+            let mut word = self.bitfield[w];
+            if remaining < 64 {
+                word <<= 64 - remaining;
+                remaining = 0;
+            } else {
+                remaining -= 64;
+            }
+            count += word.count_ones();
+        }
+        count
+    }
+
     #[inline]
     fn lost_in_shift(&self, shift_amount: u32) -> u32 {
         if shift_amount == 0 {
             return 0;
         }
-        if shift_amount > 63 {
-            return shift_amount - self.bitfield.count_ones();
+        shift_amount - self.pop_count_low(shift_amount)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn monotone_accepts_everything() {
+        let mut rp = ReplayProtector::new();
+        for n in 0..100_000_u32 {
+            assert!(rp.check_nonce(n));
+        }
+        let stats = rp.stats();
+        assert_eq!(stats.lost_packets, 0);
+        assert_eq!(stats.duplicate_packets, 0);
+        assert_eq!(stats.received_packets, 100_000);
+    }
+
+    #[test]
+    fn reorder_within_window() {
+        let mut rp = ReplayProtector::new();
+        let mut base = 0_u32;
+        while base < 50_000 {
+            for j in (0..200).rev() {
+                assert!(rp.check_nonce(base + j));
+            }
+            base += 200;
+        }
+    }
+
+    #[test]
+    fn duplicates_rejected() {
+        let mut rp = ReplayProtector::new();
+        for n in 0..1000_u32 {
+            assert!(rp.check_nonce(n));
+            assert!(!rp.check_nonce(n));
+        }
+        assert_eq!(rp.stats().duplicate_packets, 1000);
+    }
+
+    #[test]
+    fn cross_word_and_big_jumps() {
+        // straddle every word boundary of the window
+        let mut rp = ReplayProtector::new();
+        for boundary in [63_u32, 64, 127, 128, 191, 192, 255] {
+            assert!(rp.check_nonce(boundary));
+            assert!(!rp.check_nonce(boundary));
         }
-        return shift_amount - (self.bitfield << (64 - shift_amount)).count_ones();
+        // a jump far past the window forces a full clear
+        assert!(rp.check_nonce(1_000_000));
+        assert!(!rp.check_nonce(1_000_000));
+        // behind the (shifted) window is out of range
+        assert!(!rp.check_nonce(10));
+        assert!(rp.stats().received_unexpected >= 1);
     }
 }
@@ -32,23 +32,46 @@ struct AddrSet_pvt
 {
     struct AddrSet pub;
     struct ArrayList_OfAddrs* addrList;
+
+    /**
+     * Flat ip6 fingerprints in step with addrList so address matching scans
+     * a cache-line-friendly array and only chases the element pointer on a
+     * fingerprint hit. Zero only for the all-zero address, which never
+     * appears in a set.
+     */
+    uint64_t* fps;
+    int fpCapacity;
+
     struct Allocator* alloc;
     Identity
 };
 
+static uint64_t fingerprint(struct Address* addr)
+{
+    return addr->ip6.longs.one_be ^ addr->ip6.longs.two_be;
+}
+
 static int indexOf(struct AddrSet_pvt* ap, struct Address* addr, enum AddrSet_Match m)
 {
+    if (m == AddrSet_Match_LABEL_ONLY) {
+        for (int i = 0; i < ap->addrList->length; i++) {
+            struct Elem* el = ArrayList_OfAddrs_get(ap->addrList, i);
+            if (addr->path == el->addr.path) { return i; }
+        }
+        return -1;
+    }
+    if (m != AddrSet_Match_ADDRESS_ONLY && m != AddrSet_Match_BOTH) {
+        Assert_failure("wtf");
+    }
+    const uint64_t fp = fingerprint(addr);
     for (int i = 0; i < ap->addrList->length; i++) {
+        if (ap->fps[i] != fp) { continue; }
         struct Elem* el = ArrayList_OfAddrs_get(ap->addrList, i);
         // We will just match on the same IP, even if the path is not the same
         if (m == AddrSet_Match_ADDRESS_ONLY) {
             if (Address_isSameIp(addr, &el->addr)) { return i; }
-        } else if (m == AddrSet_Match_LABEL_ONLY) {
-            if (addr->path == el->addr.path) { return i; }
-        } else if (m == AddrSet_Match_BOTH) {
-            if (Address_isSame(addr, &el->addr)) { return i; }
         } else {
-            Assert_failure("wtf");
+            if (Address_isSame(addr, &el->addr)) { return i; }
         }
     }
     return -1;
@@ -71,6 +94,11 @@ void AddrSet_add(struct AddrSet* as, struct Address* addr, enum AddrSet_Match m)
     Bits_memcpy(&el->addr, addr, sizeof(struct Address));
     Identity_set(el);
     ArrayList_OfAddrs_add(ap->addrList, el);
+    if (ap->addrList->length > ap->fpCapacity) {
+        ap->fpCapacity = (ap->fpCapacity) ? ap->fpCapacity * 2 : 8;
+        ap->fps = Allocator_realloc(ap->alloc, ap->fps, ap->fpCapacity * sizeof(uint64_t));
+    }
+    ap->fps[ap->addrList->length - 1] = fingerprint(addr);
     ap->pub.length = ap->addrList->length;
 }
 
@@ -82,6 +110,9 @@ void AddrSet_remove(struct AddrSet* as, struct Address* addr, enum AddrSet_Match
         if (idx == -1) { return; }
         struct Elem* el = ArrayList_OfAddrs_get(ap->addrList, idx);
         ArrayList_OfAddrs_remove(ap->addrList, idx);
+        Bits_memmove(&ap->fps[idx],
+                     &ap->fps[idx + 1],
+                     (ap->addrList->length - idx) * sizeof(uint64_t));
         Allocator_free(el->alloc);
         ap->pub.length = ap->addrList->length;
     }
@@ -90,9 +121,10 @@ void AddrSet_remove(struct AddrSet* as, struct Address* addr, enum AddrSet_Match
 void AddrSet_flush(struct AddrSet* as)
 {
     struct AddrSet_pvt* ap = Identity_check((struct AddrSet_pvt*) as);
-    for (int i = 0; i < ap->addrList->length; i++) {
-        struct Elem* el = ArrayList_OfAddrs_get(ap->addrList, i);
-        ArrayList_OfAddrs_remove(ap->addrList, i);
+    // always take index 0: removing while counting up skips every other entry
+    while (ap->addrList->length) {
+        struct Elem* el = ArrayList_OfAddrs_get(ap->addrList, 0);
+        ArrayList_OfAddrs_remove(ap->addrList, 0);
         Allocator_free(el->alloc);
     }
     ap->pub.length = 0;
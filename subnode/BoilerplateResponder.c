@@ -19,6 +19,7 @@ struct BoilerplateResponder_pvt
 {
     struct BoilerplateResponder pub;
     struct EncodingScheme* myScheme;
+    struct EncodingScheme_Compiled* myCompiledScheme;
     String* mySchemeStr;
     Identity
 };
@@ -30,7 +31,9 @@ void BoilerplateResponder_addBoilerplate(struct BoilerplateResponder* br,
 {
     struct BoilerplateResponder_pvt* brp = Identity_check((struct BoilerplateResponder_pvt*) br);
     Dict_putStringC(msgDict, "es", brp->mySchemeStr, alloc);
-    int encIdx = EncodingScheme_getFormNum(brp->myScheme, src->path);
+    int encIdx = (brp->myCompiledScheme)
+        ? EncodingScheme_getFormNumCompiled(brp->myCompiledScheme, src->path)
+        : EncodingScheme_getFormNum(brp->myScheme, src->path);
     Assert_true(encIdx != EncodingScheme_getFormNum_INVALID);
     Dict_putIntC(msgDict, "ei", encIdx, alloc);
 }
@@ -43,6 +46,7 @@ struct BoilerplateResponder* BoilerplateResponder_new(struct EncodingScheme* myS
         Allocator_calloc(alloc, sizeof(struct BoilerplateResponder_pvt), 1);
     Identity_set(brp);
     brp->myScheme = myScheme;
+    brp->myCompiledScheme = EncodingScheme_compile(myScheme, alloc);
     brp->mySchemeStr = EncodingScheme_serialize(myScheme, alloc);
     return &brp->pub;
 }
@@ -50,21 +50,27 @@ static inline int LinkState_encode(
         .start = &msg->msgbytes[-Message_getPadding(msg)]
     };
 
+    // Nothing new to send; this also guards against ls->samples being behind
+    // lastSamples (or zero), where the old countdown underflowed and encoded
+    // a ring full of empty slots for a link with no samples yet.
+    if (ls->samples <= lastSamples) { return 0; }
+
     // Take the newest X entries where X = MIN(ls->samples - lastSamples, LinkState_SLOTS)
-    uint32_t i = ls->samples - 1;
-    int count = 0;
+    uint32_t toSend = ls->samples - lastSamples;
+    if (toSend > LinkState_SLOTS) { toSend = LinkState_SLOTS; }
+    uint32_t i = ls->samples;
     int err = 0;
-    for (; i >= lastSamples && count < LinkState_SLOTS; i--, count++) {
+    for (uint32_t count = 0; count < toSend; count++) {
+        i--;
         int idx = i % LinkState_SLOTS;
         err |= VarInt_push(&iter, ls->kbRecvSlots[idx]);
         err |= VarInt_push(&iter, ls->dropSlots[idx]);
         err |= VarInt_push(&iter, ls->lagSlots[idx]);
     }
     if (err) { return 1; }
-    if (!count) { return 0; }
 
     // index of the first slot which should be updated when parsing
-    Assert_true(!VarInt_push(&iter, (i + 1) % LinkState_SLOTS));
+    Assert_true(!VarInt_push(&iter, i % LinkState_SLOTS));
     Assert_true(!VarInt_push(&iter, ls->nodeId));
 
     int beginLength = Message_getLength(msg);
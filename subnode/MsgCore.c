@@ -56,6 +56,10 @@ struct MsgCore_pvt
 {
     struct MsgCore pub;
     struct ArrayList_OfQueryHandlers* qh;
+
+    /** The handler which matched the previous query, see getQueryHandler(). */
+    struct QueryHandler* lastQueryHandler;
+
     struct Pinger* pinger;
     struct Log* log;
     String* schemeDefinition;
@@ -218,10 +222,16 @@ struct MsgCore_Promise* MsgCore_createQuery(struct MsgCore* core,
 
 static struct QueryHandler* getQueryHandler(struct MsgCore_pvt* mcp, String* q)
 {
+    // queries arrive in runs of the same type (announce batches, getPeers
+    // sweeps), check the last match before scanning
+    if (mcp->lastQueryHandler && String_equals(mcp->lastQueryHandler->queryType, q)) {
+        return mcp->lastQueryHandler;
+    }
     for (int i = 0; i < mcp->qh->length; i++) {
         struct QueryHandler* qhx = ArrayList_OfQueryHandlers_get(mcp->qh, i);
         Identity_check(qhx);
         if (String_equals(qhx->queryType, q)) {
+            mcp->lastQueryHandler = qhx;
             return qhx;
         }
     }
@@ -255,6 +265,7 @@ static int qhOnFree(struct Allocator_OnFreeJob* job)
     for (int i = 0; i < mcp->qh->length; i++) {
         struct QueryHandler* qhx = ArrayList_OfQueryHandlers_get(mcp->qh, i);
         if (qhx == qh) {
+            if (mcp->lastQueryHandler == qh) { mcp->lastQueryHandler = NULL; }
             ArrayList_OfQueryHandlers_remove(mcp->qh, i);
             return 0;
         }
@@ -28,6 +28,14 @@
 
 #include <inttypes.h>
 
+// Announcements are already deltas: an item (peer, scheme, version) is only
+// re-sent when its content changes or when its last announcement approaches
+// AGREED_TIMEOUT_MS, with per-item jitter so re-announcements spread out
+// rather than bursting. The floor on traffic is therefore set by the agreed
+// timeout, not by redundant state. Compressing the item encoding itself is a
+// wire-protocol change the snode would have to speak; the LinkState items are
+// the only bulky part and they already use variable-width quantized samples.
+
 // This is the time between the timestamp of the newest message and the point where
 // snode and subnode agree to drop messages from the snode state.
 #define AGREED_TIMEOUT_MS (1000 * 60 * 20)
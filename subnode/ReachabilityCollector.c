@@ -413,25 +413,27 @@ static void queryBackroute(struct ReachabilityCollector_pvt* rcp, struct PeerInf
     pi->waitForResponse = true;
 }
 
+/** Number of peer probes kept in flight at once. */
+#define PROBE_PARALLEL 4
+
 static void mkNextRequest(struct ReachabilityCollector_pvt* rcp)
 {
-    struct PeerInfo_pvt* pi = NULL;
+    // Probe several peers concurrently (the queries are independent) so a
+    // full pass over the peer list takes length/PROBE_PARALLEL cycles
+    // instead of one cycle per peer.
+    int inFlight = 0;
     for (int i = 0; i < rcp->piList->length; i++) {
-        pi = ArrayList_OfPeerInfo_pvt_get(rcp->piList, i);
+        struct PeerInfo_pvt* pi = ArrayList_OfPeerInfo_pvt_get(rcp->piList, i);
         if (pi->pub.addr.protocolVersion == 0) { continue; }
-        if (pi->pub.isQuerying && !pi->waitForResponse) { break; }
-    }
-    if (!pi || !pi->pub.isQuerying) {
-        // if (rcp->piList->length > 0) {
-        //     Log_debug(rcp->log, "All [%u] peers have been queried", rcp->piList->length);
-        // }
-        return;
-    }
-    if (pi->waitForResponse) {
-        Log_debug(rcp->log, "Message outstanding, waiting for peer to respond");
-        return;
+        if (!pi->pub.isQuerying) { continue; }
+        if (pi->waitForResponse) {
+            inFlight++;
+        } else {
+            queryBackroute(rcp, pi);
+            inFlight++;
+        }
+        if (inFlight >= PROBE_PARALLEL) { return; }
     }
-    queryBackroute(rcp, pi);
 }
 
 static void cycle(void* vrc)
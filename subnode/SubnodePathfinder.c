@@ -26,6 +26,7 @@
 #include "dht/dhtcore/ReplySerializer.h"
 #include "util/AddrTools.h"
 #include "util/events/Timeout.h"
+#include "util/events/Time.h"
 #include "net/SwitchPinger.h"
 #include "switch/LabelSplicer.h"
 #include "wire/Error.h"
@@ -66,6 +67,18 @@ struct SubnodePathfinder_pvt
 
     struct AddrSet* myPeerAddrs;
 
+    /**
+     * TTL cache of snode getRoute answers: a repeat search for the same
+     * target inside the window is served locally instead of re-asking the
+     * snode. Entries are direct-mapped by the target address.
+     */
+    #define RS_CACHE_SIZE 32
+    #define RS_CACHE_TTL_MS 10000
+    struct {
+        struct Address addr;
+        uint64_t timeMs;
+    } rsCache[RS_CACHE_SIZE];
+
     struct MsgCore* msgCore;
 
     struct Admin* admin;
@@ -162,6 +175,13 @@ static Iface_DEFUN switchErr(struct Message* msg, struct SubnodePathfinder_pvt*
     return NULL;
 }
 
+static uint32_t rsCacheSlot(const uint8_t addr[16])
+{
+    uint64_t x;
+    Bits_memcpy(&x, &addr[8], 8);
+    return (uint32_t) (x ^ (x >> 32)) % RS_CACHE_SIZE;
+}
+
 struct SnodeQuery {
     struct SubnodePathfinder_pvt* pf;
     uint32_t mapHandle;
@@ -191,6 +211,13 @@ static void getRouteReply(Dict* msg, struct Address* src, struct MsgCore_Promise
         return;
     }
 
+    // remember the answer so repeat searches inside the TTL stay local
+    {
+        uint32_t slot = rsCacheSlot(al->elems[0].ip6.bytes);
+        Bits_memcpy(&pf->rsCache[slot].addr, &al->elems[0], sizeof(struct Address));
+        pf->rsCache[slot].timeMs = Time_currentTimeMilliseconds();
+    }
+
     //NodeCache_discoverNode(pf->nc, &al->elems[0]);
     struct Message* msgToCore = Message_new(0, 512, prom->alloc);
     Iface_CALL(sendNode, msgToCore, &al->elems[0], Metric_SNODE_SAYS, PFChan_Pathfinder_NODE, pf);
@@ -267,6 +294,15 @@ static Iface_DEFUN searchReq(struct Message* msg, struct SubnodePathfinder_pvt*
         return sendNode(msg, &pf->pub.snh->snodeAddr, Metric_SNODE, PFChan_Pathfinder_NODE, pf);
     }
 
+    uint32_t slot = rsCacheSlot(addr);
+    if (!Bits_memcmp(pf->rsCache[slot].addr.ip6.bytes, addr, 16)
+        && Time_currentTimeMilliseconds() - pf->rsCache[slot].timeMs < RS_CACHE_TTL_MS)
+    {
+        Log_debug(pf->log, "Answering search for [%s] from the cache", printedAddr);
+        return sendNode(msg, &pf->rsCache[slot].addr, Metric_SNODE_SAYS,
+                        PFChan_Pathfinder_NODE, pf);
+    }
+
     queryRs(pf, addr, printedAddr);
     return NULL;
 }
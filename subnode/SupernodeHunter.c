@@ -398,30 +398,40 @@ static void probePeerCycle(void* vsn)
         return;
     }
 
-    struct Address* peer = getPeerByNpn(snp, snp->nextPeer);
-    if (!peer) {
-        Log_info(snp->log, "No peer found who is version >= 20");
-        return;
-    }
+    // Race the query across a few peers per cycle: whichever snode answer
+    // comes back and confirms first wins, which selects for the lowest
+    // round-trip path without any explicit measurement.
+    for (int i = 0; i < 3; i++) {
+        struct Address* peer = getPeerByNpn(snp, snp->nextPeer);
+        if (!peer) {
+            if (!i) { Log_info(snp->log, "No peer found who is version >= 20"); }
+            return;
+        }
+
+        struct SwitchPinger_Ping* p = SwitchPinger_newPing(
+            peer->path, String_CONST(""), 3000, peerResponse, snp->alloc, snp->sp);
+        if (!p) {
+            // The pinger is shared and caps its outstanding pings; try again
+            // next cycle rather than racing more queries now.
+            Log_debug(snp->log, "SwitchPinger has no free slots, deferring peer probe");
+            return;
+        }
 
-    struct SwitchPinger_Ping* p =
-        SwitchPinger_newPing(peer->path, String_CONST(""), 3000, peerResponse, snp->alloc, snp->sp);
-    Assert_true(p);
+        Log_debug(snp->log, "Querying peer [%s] [%d] total [%d], blacklist size [%d]",
+            Address_toString(peer, p->pingAlloc)->bytes,
+            snp->nextPeer,
+            snp->myPeerAddrs->length,
+            snp->blacklist->length);
 
-    Log_debug(snp->log, "Querying peer [%s] [%d] total [%d], blacklist size [%d]",
-        Address_toString(peer, p->pingAlloc)->bytes,
-        snp->nextPeer,
-        snp->myPeerAddrs->length,
-        snp->blacklist->length);
+        snp->nextPeer++;
 
-    snp->nextPeer++;
+        p->type = SwitchPinger_Type_GETSNODE;
+        if (snp->pub.snodeIsReachable) {
+            Bits_memcpy(&p->snode, &snp->pub.snodeAddr, sizeof(struct Address));
+        }
 
-    p->type = SwitchPinger_Type_GETSNODE;
-    if (snp->pub.snodeIsReachable) {
-        Bits_memcpy(&p->snode, &snp->pub.snodeAddr, sizeof(struct Address));
+        p->onResponseContext = snp;
     }
-
-    p->onResponseContext = snp;
 }
 
 static void onSnodeUnreachable(struct SupernodeHunter* snh,
@@ -109,15 +109,11 @@ uint64_t EncodingScheme_serializeDirector(struct EncodingScheme* scheme, int dir
     return (dir << f->prefixLen) | f->prefix;
 }
 
-uint64_t EncodingScheme_convertLabel(struct EncodingScheme* scheme,
-                                     uint64_t routeLabel,
-                                     int convertTo)
+static uint64_t convertLabel(struct EncodingScheme* scheme,
+                             int formNum,
+                             uint64_t routeLabel,
+                             int convertTo)
 {
-    int formNum = EncodingScheme_getFormNum(scheme, routeLabel);
-    if (formNum == EncodingScheme_getFormNum_INVALID) {
-        return EncodingScheme_convertLabel_INVALID;
-    }
-
     struct EncodingScheme_Form* currentForm = &scheme->forms[formNum];
 
     if (scheme->count == 1
@@ -205,6 +201,46 @@ uint64_t EncodingScheme_convertLabel(struct EncodingScheme* scheme,
     return routeLabel;
 }
 
+uint64_t EncodingScheme_convertLabel(struct EncodingScheme* scheme,
+                                     uint64_t routeLabel,
+                                     int convertTo)
+{
+    int formNum = EncodingScheme_getFormNum(scheme, routeLabel);
+    if (formNum == EncodingScheme_getFormNum_INVALID) {
+        return EncodingScheme_convertLabel_INVALID;
+    }
+    return convertLabel(scheme, formNum, routeLabel, convertTo);
+}
+
+uint64_t EncodingScheme_convertLabelCompiled(const struct EncodingScheme_Compiled* compiled,
+                                             uint64_t routeLabel,
+                                             int convertTo)
+{
+    int formNum = EncodingScheme_getFormNumCompiled(compiled, routeLabel);
+    if (formNum == EncodingScheme_getFormNum_INVALID) {
+        return EncodingScheme_convertLabel_INVALID;
+    }
+    return convertLabel(compiled->scheme, formNum, routeLabel, convertTo);
+}
+
+struct EncodingScheme_Compiled* EncodingScheme_compile(struct EncodingScheme* scheme,
+                                                       struct Allocator* alloc)
+{
+    for (int i = 0; i < scheme->count; i++) {
+        if (scheme->forms[i].prefixLen > EncodingScheme_compile_TABLE_BITS) {
+            // a prefix wider than the table index, cannot compile this scheme
+            return NULL;
+        }
+    }
+    struct EncodingScheme_Compiled* out =
+        Allocator_calloc(alloc, sizeof(struct EncodingScheme_Compiled), 1);
+    out->scheme = scheme;
+    for (uint32_t low = 0; low < (1 << EncodingScheme_compile_TABLE_BITS); low++) {
+        out->formNum[low] = EncodingScheme_getFormNum(scheme, (uint64_t) low);
+    }
+    return out;
+}
+
 /**
  * Decode a form from its binary representation.
  * Can only use a maximum of 41 bits.
@@ -46,6 +46,36 @@ struct EncodingScheme
 #define EncodingScheme_getFormNum_INVALID -1
 int EncodingScheme_getFormNum(struct EncodingScheme* scheme, uint64_t routeLabel);
 
+/**
+ * Compiled representation of a scheme: a flat table mapping the low bits of a
+ * label directly to the form number, so the per-label form lookup is one load
+ * instead of a walk over the form list. Valid as long as the scheme it was
+ * compiled from.
+ */
+#define EncodingScheme_compile_TABLE_BITS 8
+struct EncodingScheme_Compiled
+{
+    struct EncodingScheme* scheme;
+    int8_t formNum[1 << EncodingScheme_compile_TABLE_BITS];
+};
+
+/**
+ * Compile a scheme, returns NULL if any form's prefix is wider than the table
+ * index (never the case for schemes peers actually announce).
+ */
+struct EncodingScheme_Compiled* EncodingScheme_compile(struct EncodingScheme* scheme,
+                                                       struct Allocator* alloc);
+
+static inline int EncodingScheme_getFormNumCompiled(const struct EncodingScheme_Compiled* compiled,
+                                                    uint64_t routeLabel)
+{
+    return compiled->formNum[routeLabel & ((1 << EncodingScheme_compile_TABLE_BITS) - 1)];
+}
+
+uint64_t EncodingScheme_convertLabelCompiled(const struct EncodingScheme_Compiled* compiled,
+                                             uint64_t routeLabel,
+                                             int convertTo);
+
 /**
  * Convert the first director in a label from it's current form to the form given by convertTo.
  * convertTo must be between zero and scheme->count unless you are asking for the cannonical form
@@ -49,6 +49,39 @@ static inline uint64_t LabelSplicer_splice(uint64_t goHere, uint64_t viaHere)
     return ((goHere ^ 1) << log2ViaHere) ^ viaHere;
 }
 
+/**
+ * Splice a batch of labels onto one path fragment.
+ * This is for the route-derivation loops which splice many candidate routes
+ * through the same peer: the fragment's width is computed once and the loop
+ * body is branch free so the compiler can vectorize it.
+ *
+ * @param labelsInOut the goHere labels, overwritten with the spliced results,
+ *                    UINT64_MAX where the result would not fit.
+ * @param count how many labels.
+ * @param viaHere the path fragment to splice every label through.
+ */
+static inline void LabelSplicer_spliceN(uint64_t* labelsInOut, uint32_t count, uint64_t viaHere)
+{
+    const uint64_t log2ViaHere = Bits_log2x64(viaHere);
+    const uint64_t maxGoHere = (log2ViaHere > 59) ? 0 : (UINT64_MAX >> (4 + log2ViaHere));
+    for (uint32_t i = 0; i < count; i++) {
+        const uint64_t goHere = labelsInOut[i];
+        const uint64_t spliced = ((goHere ^ 1) << log2ViaHere) ^ viaHere;
+        labelsInOut[i] = (goHere > maxGoHere) ? UINT64_MAX : spliced;
+    }
+}
+
+/**
+ * Unsplice a batch of full paths from the same mid path, see LabelSplicer_unsplice().
+ */
+static inline void LabelSplicer_unspliceN(uint64_t* fullPathsInOut, uint32_t count, uint64_t midPath)
+{
+    const uint64_t log2MidPath = Bits_log2x64(midPath);
+    for (uint32_t i = 0; i < count; i++) {
+        fullPathsInOut[i] >>= log2MidPath;
+    }
+}
+
 /**
  * Determine if the route to one node passes through another node.
  * Given:
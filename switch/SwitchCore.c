@@ -32,6 +32,11 @@
 #include <inttypes.h>
 #include <stdbool.h>
 
+#include "util/events/Time.h"
+
+/** Error responses refill at one token per millisecond, burst up to the bucket size. */
+#define ERROR_BUCKET_SIZE 64
+
 struct SwitchInterface
 {
     struct Iface iface;
@@ -42,13 +47,49 @@ struct SwitchInterface
 
     struct Allocator_OnFreeJob* onFree;
 
+    /** Token bucket which rate limits error responses out of this interface. */
+    uint32_t errorTokens;
+    uint64_t errorTokensTimeMs;
+
+    /** Forwarding-path counters, snapshotted by SwitchCore_admin. */
+    struct SwitchCore_InterfaceStats stats;
+
     Identity
 };
 
+/**
+ * The number of low label bits which fully determine the destination interface.
+ * Every NumberCompress scheme reads at most 10 bits (discriminator plus suffix),
+ * so a table indexed by the low 10 bits of the label gives the decoded interface
+ * number and the bit width in a single load, skipping the branchy decode path.
+ */
+#define SwitchCore_LABEL_CACHE_BITS 10
+#define SwitchCore_LABEL_CACHE_SIZE (1 << SwitchCore_LABEL_CACHE_BITS)
+
+/** Sampled in-band flight recorder, drained by SwitchCore_admin. */
+#define SwitchCore_TRACE_SIZE 256
+
 struct SwitchCore_pvt
 {
     struct SwitchCore pub;
     struct SwitchInterface interfaces[NumberCompress_INTERFACES];
+
+    /**
+     * Label decode cache, indexed by the low bits of the label.
+     * Each entry packs NumberCompress_bitsUsedForLabel() in the top 4 bits and the
+     * decompressed interface number in the bottom 12. The table is a pure function
+     * of the compiled NumberCompress scheme so it never goes stale: interface
+     * add/remove needs no invalidation because liveness is checked against
+     * interfaces[destIndex].alloc on every lookup.
+     */
+    uint16_t labelDecodeCache[SwitchCore_LABEL_CACHE_SIZE];
+
+    /** Flight recorder ring, one packet in (traceMask+1) is recorded. */
+    struct SwitchCore_TraceEntry trace[SwitchCore_TRACE_SIZE];
+    uint64_t traceSeq;
+    uint32_t traceCounter;
+    uint32_t traceMask;
+
     bool routerAdded;
     struct Log* logger;
     struct EventBase* eventBase;
@@ -64,23 +105,49 @@ struct ErrorPacket8 {
 };
 Assert_compileTime(sizeof(struct ErrorPacket8) == SwitchHeader_SIZE + 4 + sizeof(struct Control));
 
-static inline Iface_DEFUN sendError(struct SwitchInterface* iface,
-                                    struct Message* cause,
-                                    uint32_t code,
-                                    struct Log* logger)
+/**
+ * Turn a message which cannot be forwarded into an error packet, in place.
+ *
+ * @return the index of the interface which the error packet must be bounced back to,
+ *         or -1 if the message is consumed, in which case *errOut is set unless the
+ *         cause asked for errors to be suppressed.
+ */
+static inline int prepareError(struct SwitchInterface* iface,
+                               struct Message* cause,
+                               uint32_t code,
+                               struct RTypes_Error_t** errOut)
 {
+    struct SwitchCore_pvt* core = Identity_check(iface->core);
+    struct Log* logger = core->logger;
+
+    // Refill the interface's error token bucket, then take a token or drop silently.
+    // A flood of unroutable packets must not amplify into a flood of error packets
+    // (each one costs a label reversal and a checksum on the forwarding path).
+    iface->stats.dropPackets++;
+
+    const uint64_t nowMs = Time_currentTimeMilliseconds();
+    uint64_t refill = nowMs - iface->errorTokensTimeMs;
+    if (refill > ERROR_BUCKET_SIZE) { refill = ERROR_BUCKET_SIZE; }
+    iface->errorTokens += refill;
+    if (iface->errorTokens > ERROR_BUCKET_SIZE) { iface->errorTokens = ERROR_BUCKET_SIZE; }
+    iface->errorTokensTimeMs = nowMs;
+    if (!iface->errorTokens) { return -1; }
+    iface->errorTokens--;
+
     if (Message_getLength(cause) < SwitchHeader_SIZE + 4) {
         Log_debug(logger, "runt");
-        return Error(cause, "RUNT");
+        *errOut = Error(cause, "RUNT");
+        return -1;
     }
 
     struct SwitchHeader* causeHeader = (struct SwitchHeader*) cause->msgbytes;
 
     if (SwitchHeader_getSuppressErrors(causeHeader)) {
         // don't send errors if they're asking us to suppress them!
-        return NULL;
+        return -1;
     }
 
+
     // limit of 256 bytes
     if (Message_getLength(cause) > Control_Error_MAX_SIZE) {
         Er_assert(Message_truncate(cause, Control_Error_MAX_SIZE));
@@ -106,28 +173,42 @@ static inline Iface_DEFUN sendError(struct SwitchInterface* iface,
     err->ctrl.header.checksum_be =
         Checksum_engine_be((uint8_t*) &err->ctrl, Message_getLength(cause) - SwitchHeader_SIZE - 4);
 
-    return Iface_next(&iface->iface, cause);
+    return iface - core->interfaces;
 }
 
 #define DEBUG_SRC_DST(logger, message) \
     Log_debug(logger, message " ([%u] to [%u])", sourceIndex, destIndex)
 
-/** This never returns an error, it sends an error packet instead. */
-static Iface_DEFUN receiveMessage(struct Message* message, struct Iface* iface)
+/**
+ * Compute the destination interface for a message and rewrite its header in place.
+ *
+ * On success the index of the destination interface is returned and the message is
+ * ready to be forwarded to it. If the message must be bounced back as an error packet,
+ * the error packet is built in place and the source interface's index is returned.
+ * If the message is consumed (dropped), -1 is returned and *errOut is set.
+ */
+static int routeMessage(struct Message* message,
+                        struct SwitchInterface* sourceIf,
+                        struct RTypes_Error_t** errOut)
 {
-    struct SwitchInterface* sourceIf = Identity_check((struct SwitchInterface*) iface);
     struct SwitchCore_pvt* core = Identity_check(sourceIf->core);
 
+    sourceIf->stats.recvPackets++;
+    sourceIf->stats.recvBytes += Message_getLength(message);
+
     if (Message_getLength(message) < SwitchHeader_SIZE) {
         Log_debug(core->logger, "DROP runt");
-        return Error(message, "RUNT");
+        sourceIf->stats.dropPackets++;
+        *errOut = Error(message, "RUNT");
+        return -1;
     }
 
     struct SwitchHeader* header = (struct SwitchHeader*) message->msgbytes;
     const uint64_t label = Endian_bigEndianToHost64(header->label_be);
-    uint32_t bits = NumberCompress_bitsUsedForLabel(label);
+    const uint16_t cacheEntry = core->labelDecodeCache[label & (SwitchCore_LABEL_CACHE_SIZE - 1)];
+    uint32_t bits = cacheEntry >> 12;
     const uint32_t sourceIndex = sourceIf - core->interfaces;
-    const uint32_t destIndex = NumberCompress_getDecompressed(label, bits);
+    const uint32_t destIndex = cacheEntry & 0xfff;
     const uint32_t sourceBits = NumberCompress_bitsUsedForNumber(sourceIndex);
 
     Assert_true(destIndex < NumberCompress_INTERFACES);
@@ -138,7 +219,7 @@ static Iface_DEFUN receiveMessage(struct Message* message, struct Iface* iface)
         DEBUG_SRC_DST(core->logger,
                         "DROP packet for this router because the destination "
                         "discriminator was wrong");
-        return sendError(sourceIf, message, Error_MALFORMED_ADDRESS, core->logger);
+        return prepareError(sourceIf, message, Error_MALFORMED_ADDRESS, errOut);
     }
 
     if (sourceBits > bits) {
@@ -162,7 +243,7 @@ static Iface_DEFUN receiveMessage(struct Message* message, struct Iface* iface)
                 DEBUG_SRC_DST(core->logger,
                               "DROP packet for this router because there is no way to "
                               "represent the return path.");
-                return sendError(sourceIf, message, Error_RETURN_PATH_INVALID, core->logger);
+                return prepareError(sourceIf, message, Error_RETURN_PATH_INVALID, errOut);
             }
             bits = sourceBits;
         } else if (1 == sourceIndex) {
@@ -175,13 +256,13 @@ static Iface_DEFUN receiveMessage(struct Message* message, struct Iface* iface)
                 // not enough zeroes
                 DEBUG_SRC_DST(core->logger, "DROP packet because source address is "
                                                       "larger than destination address.");
-                return sendError(sourceIf, message, Error_MALFORMED_ADDRESS, core->logger);
+                return prepareError(sourceIf, message, Error_MALFORMED_ADDRESS, errOut);
             }
         } else {
             //Log_info(core->logger, "source exceeds dest");
             DEBUG_SRC_DST(core->logger, "DROP packet because source address is "
                                                   "larger than destination address.");
-            return sendError(sourceIf, message, Error_MALFORMED_ADDRESS, core->logger);
+            return prepareError(sourceIf, message, Error_MALFORMED_ADDRESS, errOut);
         }
     }
 
@@ -192,34 +273,117 @@ static Iface_DEFUN receiveMessage(struct Message* message, struct Iface* iface)
         // This is important, but it's someone else's important problem
         // DEBUG_SRC_DST(core->logger, "DROP packet because there is no interface "
         //                                       "where the bits specify.");
-        return sendError(sourceIf, message, Error_MALFORMED_ADDRESS, core->logger);
+        return prepareError(sourceIf, message, Error_MALFORMED_ADDRESS, errOut);
     }
 
     /*if (sourceIndex == destIndex && sourceIndex != 1) {
         DEBUG_SRC_DST(core->logger, "DROP Packet with redundant route.");
-        return sendError(sourceIf, message, Error_LOOP_ROUTE, core->logger);
+        return prepareError(sourceIf, message, Error_LOOP_ROUTE, errOut);
     }*/
 
     uint64_t sourceLabel = Bits_bitReverse64(NumberCompress_getCompressed(sourceIndex, bits));
     uint64_t targetLabel = (label >> bits) | sourceLabel;
 
-    int cloneLength = (Message_getLength(message) < Control_Error_MAX_SIZE) ?
-        Message_getLength(message) : Control_Error_MAX_SIZE;
-    uint8_t messageClone[Control_Error_MAX_SIZE];
-    Bits_memcpy(messageClone, message->msgbytes, cloneLength);
-
     // Update the header
     header->label_be = Endian_hostToBigEndian64(targetLabel);
     uint32_t labelShift = SwitchHeader_getLabelShift(header) + bits;
     if (labelShift > 63) {
         // TODO(cjd): hmm should we return an error packet?
         Log_debug(core->logger, "Label rolled over");
-        return Error(message, "UNDELIVERABLE");
+        sourceIf->stats.dropPackets++;
+        *errOut = Error(message, "UNDELIVERABLE");
+        return -1;
     }
     SwitchHeader_setLabelShift(header, labelShift);
     SwitchHeader_setTrafficClass(header, 0xffff);
 
-    return Iface_next(&core->interfaces[destIndex].iface, message);
+    return destIndex;
+}
+
+/** Record one sampled packet into the flight recorder ring. */
+static void traceRecord(struct SwitchCore_pvt* core,
+                        struct Message* message,
+                        int sourceIndex,
+                        int destIndex)
+{
+    struct SwitchCore_TraceEntry* e = &core->trace[core->traceSeq % SwitchCore_TRACE_SIZE];
+    e->seq = ++core->traceSeq;
+    e->timeMs = Time_currentTimeMilliseconds();
+    e->label = 0;
+    if (Message_getLength(message) >= SwitchHeader_SIZE) {
+        e->label =
+            Endian_bigEndianToHost64(((struct SwitchHeader*) message->msgbytes)->label_be);
+    }
+    e->length = Message_getLength(message);
+    e->sourceIf = sourceIndex;
+    e->destIf = destIndex;
+}
+
+/** This never returns an error, it sends an error packet instead. */
+static Iface_DEFUN receiveMessage(struct Message* message, struct Iface* iface)
+{
+    struct SwitchInterface* sourceIf = Identity_check((struct SwitchInterface*) iface);
+    struct SwitchCore_pvt* core = Identity_check(sourceIf->core);
+
+    const bool doTrace = !(++core->traceCounter & core->traceMask);
+    struct RTypes_Error_t* err = NULL;
+    int destIndex = routeMessage(message, sourceIf, &err);
+    if (doTrace) {
+        traceRecord(core, message, sourceIf - core->interfaces, destIndex);
+    }
+    if (destIndex < 0) { return err; }
+    struct SwitchInterface* destIf = &core->interfaces[destIndex];
+    destIf->stats.sendPackets++;
+    destIf->stats.sendBytes += Message_getLength(message);
+    return Iface_next(&destIf->iface, message);
+}
+
+struct RTypes_Error_t* SwitchCore_receiveMessageVec(struct Message** messages,
+                                                    uint32_t count,
+                                                    struct Iface* iface)
+{
+    struct SwitchInterface* sourceIf = Identity_check((struct SwitchInterface*) iface);
+    struct SwitchCore_pvt* core = Identity_check(sourceIf->core);
+    Assert_true(count <= Iface_VEC_MAX);
+
+    struct RTypes_Error_t* err = NULL;
+    int dests[Iface_VEC_MAX];
+    bool classed[Iface_VEC_MAX];
+
+    // First pass: route every message while the label logic and headers are hot in cache.
+    // The sender's traffic classification is captured before routing erases it, packets
+    // which the sender marked latency sensitive leave ahead of unclassed bulk below.
+    for (uint32_t i = 0; i < count; i++) {
+        struct RTypes_Error_t* e = NULL;
+        const bool doTrace = !(++core->traceCounter & core->traceMask);
+        classed[i] = Message_getLength(messages[i]) >= SwitchHeader_SIZE
+            && SwitchHeader_getTrafficClass((struct SwitchHeader*) messages[i]->msgbytes) != 0xffff;
+        dests[i] = routeMessage(messages[i], sourceIf, &e);
+        if (doTrace) {
+            traceRecord(core, messages[i], sourceIf - core->interfaces, dests[i]);
+        }
+        if (e && !err) { err = e; }
+    }
+
+    // Second pass: forward classed traffic first, then bulk, grouping messages bound
+    // for the same interface together so the destination's state is only pulled into
+    // cache once per group. Order within a class is preserved.
+    for (int wantClassed = 1; wantClassed >= 0; wantClassed--) {
+        for (uint32_t i = 0; i < count; i++) {
+            if (dests[i] < 0 || classed[i] != (bool) wantClassed) { continue; }
+            const int destIndex = dests[i];
+            struct SwitchInterface* destIf = &core->interfaces[destIndex];
+            for (uint32_t j = i; j < count; j++) {
+                if (dests[j] != destIndex || classed[j] != (bool) wantClassed) { continue; }
+                dests[j] = -1;
+                destIf->stats.sendPackets++;
+                destIf->stats.sendBytes += Message_getLength(messages[j]);
+                struct RTypes_Error_t* e = Iface_send(&destIf->iface, messages[j]);
+                if (e && !err) { err = e; }
+            }
+        }
+    }
+    return err;
 }
 
 static int removeInterface(struct Allocator_OnFreeJob* job)
@@ -289,6 +453,16 @@ struct SwitchCore* SwitchCore_new(struct Log* logger,
     core->logger = logger;
     core->eventBase = base;
 
+    core->traceMask = SwitchCore_TRACE_DEFAULT_MASK;
+
+    for (uint32_t low = 0; low < SwitchCore_LABEL_CACHE_SIZE; low++) {
+        const uint32_t bits = NumberCompress_bitsUsedForLabel((uint64_t) low);
+        const uint32_t destIndex = NumberCompress_getDecompressed((uint64_t) low, bits);
+        Assert_true(bits <= SwitchCore_LABEL_CACHE_BITS);
+        Assert_true(destIndex < NumberCompress_INTERFACES && destIndex < (1 << 12));
+        core->labelDecodeCache[low] = (uint16_t) ((bits << 12) | destIndex);
+    }
+
     struct SwitchInterface* routerIf = &core->interfaces[1];
     Identity_set(routerIf);
     routerIf->iface.send = receiveMessage;
@@ -298,3 +472,46 @@ struct SwitchCore* SwitchCore_new(struct Log* logger,
 
     return &core->pub;
 }
+
+int SwitchCore_getInterfaceStats(struct SwitchCore* switchCore,
+                                 int ifNum,
+                                 struct SwitchCore_InterfaceStats* statsOut)
+{
+    struct SwitchCore_pvt* core = Identity_check((struct SwitchCore_pvt*)switchCore);
+    if (ifNum < 0 || ifNum >= NumberCompress_INTERFACES) { return -1; }
+    struct SwitchInterface* si = &core->interfaces[ifNum];
+    if (!si->iface.send) { return 0; }
+    Bits_memcpy(statsOut, &si->stats, sizeof(struct SwitchCore_InterfaceStats));
+    return 1;
+}
+
+int SwitchCore_getTrace(struct SwitchCore* switchCore,
+                        uint64_t since,
+                        struct SwitchCore_TraceEntry* entriesOut,
+                        int maxEntries)
+{
+    struct SwitchCore_pvt* core = Identity_check((struct SwitchCore_pvt*)switchCore);
+    uint64_t oldest =
+        (core->traceSeq > SwitchCore_TRACE_SIZE) ? core->traceSeq - SwitchCore_TRACE_SIZE : 0;
+    if (since < oldest) { since = oldest; }
+    int count = 0;
+    for (uint64_t seq = since + 1; seq <= core->traceSeq && count < maxEntries; seq++) {
+        struct SwitchCore_TraceEntry* e = &core->trace[(seq - 1) % SwitchCore_TRACE_SIZE];
+        if (e->seq != seq) { continue; }
+        Bits_memcpy(&entriesOut[count++], e, sizeof(struct SwitchCore_TraceEntry));
+    }
+    return count;
+}
+
+void SwitchCore_setTraceSampling(struct SwitchCore* switchCore, int oneInLog2)
+{
+    struct SwitchCore_pvt* core = Identity_check((struct SwitchCore_pvt*)switchCore);
+    if (oneInLog2 < 0) {
+        // effectively off
+        core->traceMask = UINT32_MAX;
+    } else if (oneInLog2 > 30) {
+        core->traceMask = ((uint32_t)1 << 30) - 1;
+    } else {
+        core->traceMask = ((uint32_t)1 << oneInLog2) - 1;
+    }
+}
@@ -40,6 +40,53 @@ struct SwitchCore* SwitchCore_new(struct Log* logger,
                                   struct Allocator* allocator,
                                   struct EventBase* base);
 
+/** Snapshot of the forwarding counters for one switch interface. */
+struct SwitchCore_InterfaceStats
+{
+    uint64_t recvPackets;
+    uint64_t recvBytes;
+    uint64_t sendPackets;
+    uint64_t sendBytes;
+    uint64_t dropPackets;
+};
+
+/**
+ * Snapshot the counters for an interface.
+ *
+ * @return 1 if statsOut was filled in, 0 if the interface slot is vacant,
+ *         -1 if ifNum is out of range.
+ */
+int SwitchCore_getInterfaceStats(struct SwitchCore* switchCore,
+                                 int ifNum,
+                                 struct SwitchCore_InterfaceStats* statsOut);
+
+/** One packet in 2^10 is recorded by default. */
+#define SwitchCore_TRACE_DEFAULT_MASK 1023
+
+/** One sampled packet in the flight recorder, see SwitchCore_getTrace(). */
+struct SwitchCore_TraceEntry
+{
+    uint64_t seq;
+    uint64_t timeMs;
+    uint64_t label;
+    uint32_t length;
+    /** Source interface, and destination or -1 if the packet was consumed. */
+    int32_t sourceIf;
+    int32_t destIf;
+};
+
+/**
+ * Copy out flight-recorder entries with sequence numbers greater than since.
+ * @return the number of entries written to entriesOut.
+ */
+int SwitchCore_getTrace(struct SwitchCore* switchCore,
+                        uint64_t since,
+                        struct SwitchCore_TraceEntry* entriesOut,
+                        int maxEntries);
+
+/** Sample one packet in 2^oneInLog2 (0 = every packet, negative = off). */
+void SwitchCore_setTraceSampling(struct SwitchCore* switchCore, int oneInLog2);
+
 #define SwitchCore_addInterface_OUT_OF_SPACE -1
 int SwitchCore_addInterface(struct SwitchCore* switchCore,
                             struct Iface* iface,
@@ -48,4 +95,16 @@ int SwitchCore_addInterface(struct SwitchCore* switchCore,
 
 void SwitchCore_swapInterfaces(struct Iface* if1, struct Iface* if2);
 
+/**
+ * Batch entry point into the switch, an Iface_CallbackVec.
+ *
+ * Drivers which pull multiple packets off the wire in one go may call this with their
+ * switch-side iface (the one registered with SwitchCore_addInterface()) instead of
+ * pushing the packets through Iface_send() one at a time. Messages are routed in a
+ * single pass and forwarded grouped by destination interface.
+ */
+struct RTypes_Error_t* SwitchCore_receiveMessageVec(struct Message** messages,
+                                                    uint32_t count,
+                                                    struct Iface* iface);
+
 #endif
@@ -0,0 +1,134 @@
+/* vim: set expandtab ts=4 sw=4: */
+/*
+ * You may redistribute this program and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "admin/Admin.h"
+#include "benc/Int.h"
+#include "benc/Dict.h"
+#include "benc/List.h"
+#include "switch/SwitchCore.h"
+#include "switch/SwitchCore_admin.h"
+#include "util/AddrTools.h"
+#include "util/Identity.h"
+
+struct Context
+{
+    struct Allocator* alloc;
+    struct SwitchCore* switchCore;
+    struct Admin* admin;
+    Identity
+};
+
+#define ENTRIES_PER_PAGE 64
+static void getStats(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
+{
+    struct Context* context = Identity_check((struct Context*) vcontext);
+
+    int64_t* page = Dict_getIntC(args, "page");
+    int i = (page) ? *page * ENTRIES_PER_PAGE : 0;
+
+    List* list = List_new(requestAlloc);
+    int counter = 0;
+    int more = 0;
+    for (;; i++) {
+        struct SwitchCore_InterfaceStats stats;
+        int ret = SwitchCore_getInterfaceStats(context->switchCore, i, &stats);
+        if (ret < 0) { break; }
+        if (!ret) { continue; }
+        if (counter++ == ENTRIES_PER_PAGE) { more = 1; break; }
+        Dict* d = Dict_new(requestAlloc);
+        Dict_putIntC(d, "ifNum", i, requestAlloc);
+        Dict_putIntC(d, "recvPackets", stats.recvPackets, requestAlloc);
+        Dict_putIntC(d, "recvBytes", stats.recvBytes, requestAlloc);
+        Dict_putIntC(d, "sendPackets", stats.sendPackets, requestAlloc);
+        Dict_putIntC(d, "sendBytes", stats.sendBytes, requestAlloc);
+        Dict_putIntC(d, "dropPackets", stats.dropPackets, requestAlloc);
+        List_addDict(list, d, requestAlloc);
+    }
+
+    Dict* r = Dict_new(requestAlloc);
+    Dict_putListC(r, "interfaces", list, requestAlloc);
+    if (more) {
+        Dict_putIntC(r, "more", 1, requestAlloc);
+    }
+    Admin_sendMessage(r, txid, context->admin);
+}
+
+#define TRACE_PAGE 32
+static void getTrace(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
+{
+    struct Context* context = Identity_check((struct Context*) vcontext);
+    int64_t* sinceP = Dict_getIntC(args, "since");
+    uint64_t since = (sinceP && *sinceP > 0) ? (uint64_t) *sinceP : 0;
+
+    struct SwitchCore_TraceEntry entries[TRACE_PAGE];
+    int num = SwitchCore_getTrace(context->switchCore, since, entries, TRACE_PAGE);
+
+    List* list = List_new(requestAlloc);
+    uint64_t lastSeq = since;
+    for (int i = 0; i < num; i++) {
+        Dict* d = Dict_new(requestAlloc);
+        Dict_putIntC(d, "seq", entries[i].seq, requestAlloc);
+        Dict_putIntC(d, "time", entries[i].timeMs, requestAlloc);
+        String* label = String_newBinary(NULL, 19, requestAlloc);
+        AddrTools_printPath(label->bytes, entries[i].label);
+        Dict_putStringC(d, "label", label, requestAlloc);
+        Dict_putIntC(d, "length", entries[i].length, requestAlloc);
+        Dict_putIntC(d, "sourceIf", entries[i].sourceIf, requestAlloc);
+        Dict_putIntC(d, "destIf", entries[i].destIf, requestAlloc);
+        List_addDict(list, d, requestAlloc);
+        lastSeq = entries[i].seq;
+    }
+
+    Dict* out = Dict_new(requestAlloc);
+    Dict_putListC(out, "entries", list, requestAlloc);
+    Dict_putIntC(out, "lastSeq", lastSeq, requestAlloc);
+    Admin_sendMessage(out, txid, context->admin);
+}
+
+static void setTraceSampling(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
+{
+    struct Context* context = Identity_check((struct Context*) vcontext);
+    int64_t* bits = Dict_getIntC(args, "oneInLog2");
+    SwitchCore_setTraceSampling(context->switchCore, (bits) ? (int) *bits : -1);
+    Dict* out = Dict_new(requestAlloc);
+    Dict_putStringCC(out, "error", "none", requestAlloc);
+    Admin_sendMessage(out, txid, context->admin);
+}
+
+void SwitchCore_admin_register(struct SwitchCore* switchCore,
+                               struct Admin* admin,
+                               struct Allocator* alloc)
+{
+    struct Context* ctx = Allocator_clone(alloc, (&(struct Context) {
+        .alloc = alloc,
+        .switchCore = switchCore,
+        .admin = admin
+    }));
+    Identity_set(ctx);
+
+    Admin_registerFunction("SwitchCore_getStats", getStats, ctx, true,
+        ((struct Admin_FunctionArg[]) {
+            { .name = "page", .required = 0, .type = "Int" }
+        }), admin);
+
+    Admin_registerFunction("SwitchCore_getTrace", getTrace, ctx, true,
+        ((struct Admin_FunctionArg[]) {
+            { .name = "since", .required = 0, .type = "Int" }
+        }), admin);
+
+    Admin_registerFunction("SwitchCore_setTraceSampling", setTraceSampling, ctx, true,
+        ((struct Admin_FunctionArg[]) {
+            { .name = "oneInLog2", .required = 0, .type = "Int" }
+        }), admin);
+}
@@ -95,6 +95,31 @@ static void assertEqual(struct EncodingScheme* a,
         !Bits_memcmp(a->forms, b->forms, sizeof(struct EncodingScheme_Form) * a->count));
 }
 
+/**
+ * The compiled form-lookup table must agree with the form-list walk for any
+ * label; a wrong table entry would corrupt route labels in NodeStore.
+ */
+static void compiledEquivalence(struct EncodingScheme* scheme,
+                                struct Random* rand,
+                                struct Allocator* alloc)
+{
+    struct EncodingScheme_Compiled* compiled = EncodingScheme_compile(scheme, alloc);
+    if (!compiled) {
+        // a form's prefix is wider than the table index, callers fall back
+        return;
+    }
+    for (int i = 0; i < 64; i++) {
+        uint64_t label = Random_uint64(rand) >> (Random_uint32(rand) % 64);
+        Assert_true(EncodingScheme_getFormNumCompiled(compiled, label)
+            == EncodingScheme_getFormNum(scheme, label));
+        int convertTo = (i & 1)
+            ? EncodingScheme_convertLabel_convertTo_CANNONICAL
+            : (int) (Random_uint32(rand) % (scheme->count + 1));
+        Assert_true(EncodingScheme_convertLabelCompiled(compiled, label, convertTo)
+            == EncodingScheme_convertLabel(scheme, label, convertTo));
+    }
+}
+
 static void randomTest(struct Allocator* parent, struct Random* rand)
 {
     struct Allocator* alloc = Allocator_child(parent);
@@ -102,6 +127,7 @@ static void randomTest(struct Allocator* parent, struct Random* rand)
     String* data = EncodingScheme_serialize(control, alloc);
     struct EncodingScheme* test = EncodingScheme_deserialize(data, alloc);
     assertEqual(control, test);
+    compiledEquivalence(control, rand, alloc);
     Allocator_free(alloc);
 }
 
@@ -39,6 +39,32 @@ static void splice()
     Assert_true(expected == out);
 }
 
+static void spliceN()
+{
+    // spliceN must agree with splice, including the too-big case.
+    uint64_t labels[] = {
+        Constant_base2(000000100),
+        1,
+        0x13,
+        UINT64_MAX >> 4,
+        UINT64_MAX >> 3
+    };
+    uint64_t viaHere = Constant_base2(000000100);
+    uint64_t batch[5];
+    for (int i = 0; i < 5; i++) { batch[i] = labels[i]; }
+
+    LabelSplicer_spliceN(batch, 5, viaHere);
+    for (int i = 0; i < 5; i++) {
+        Assert_true(batch[i] == LabelSplicer_splice(labels[i], viaHere));
+    }
+
+    for (int i = 0; i < 5; i++) { batch[i] = LabelSplicer_splice(labels[i], 0x13); }
+    LabelSplicer_unspliceN(batch, 5, 0x13);
+    for (int i = 0; i < 5; i++) {
+        Assert_true(batch[i] == LabelSplicer_unsplice(LabelSplicer_splice(labels[i], 0x13), 0x13));
+    }
+}
+
 static void routesThrough()
 {
     uint64_t dst = Constant_base2(0000000000000000100100000000101011101010100101011100101001010101);
@@ -50,6 +76,7 @@ static void routesThrough()
 int main()
 {
     splice();
+    spliceN();
     routesThrough();
     unsplice();
     return 0;
@@ -0,0 +1,152 @@
+/* vim: set expandtab ts=4 sw=4: */
+/*
+ * You may redistribute this program and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "switch/SwitchCore.h"
+
+#define NumberCompress_OLD_CODE
+#include "switch/NumberCompress.h"
+
+#include "memory/MallocAllocator.h"
+#include "util/log/FileWriterLog.h"
+#include "util/Assert.h"
+#include "util/Endian.h"
+#include "wire/Message.h"
+#include "wire/SwitchHeader.h"
+
+#include <stdio.h>
+
+#define ENDPOINTS 3
+#define MAX_RECEIVED 64
+
+struct Endpoint
+{
+    struct Iface iface;
+    uint64_t label;
+    int index;
+};
+
+static struct
+{
+    /** Global arrival sequence, so cross-endpoint ordering can be asserted. */
+    int arrivalCount;
+
+    /** Per arrival: which endpoint got it and the payload marker byte. */
+    int arrivedAt[MAX_RECEIVED];
+    uint8_t marker[MAX_RECEIVED];
+    uint8_t headerBytes[MAX_RECEIVED][SwitchHeader_SIZE];
+} ctx;
+
+static struct RTypes_Error_t* receiveMessage(struct Message* msg, struct Iface* iface)
+{
+    struct Endpoint* ep = (struct Endpoint*) iface;
+    Assert_true(ctx.arrivalCount < MAX_RECEIVED);
+    Assert_true(Message_getLength(msg) >= SwitchHeader_SIZE + 1);
+    ctx.arrivedAt[ctx.arrivalCount] = ep->index;
+    ctx.marker[ctx.arrivalCount] = msg->msgbytes[Message_getLength(msg) - 1];
+    Bits_memcpy(ctx.headerBytes[ctx.arrivalCount], msg->msgbytes, SwitchHeader_SIZE);
+    ctx.arrivalCount++;
+    return NULL;
+}
+
+static struct Message* mkMessage(uint64_t label,
+                                 uint16_t trafficClass,
+                                 uint8_t marker,
+                                 struct Allocator* alloc)
+{
+    // payload is big enough that even a bounced error can quote the message
+    struct Message* msg = Message_new(SwitchHeader_SIZE + 8, 512, alloc);
+    Bits_memset(msg->msgbytes, 0, Message_getLength(msg));
+    struct SwitchHeader* sh = (struct SwitchHeader*) msg->msgbytes;
+    sh->label_be = Endian_hostToBigEndian64(label);
+    SwitchHeader_setVersion(sh, SwitchHeader_CURRENT_VERSION);
+    SwitchHeader_setTrafficClass(sh, trafficClass);
+    msg->msgbytes[Message_getLength(msg) - 1] = marker;
+    return msg;
+}
+
+int main()
+{
+    struct Allocator* alloc = MallocAllocator_new(1 << 20);
+    struct Log* logger = FileWriterLog_new(stdout, alloc);
+
+    // The event base is stored but never touched by the forwarding paths.
+    struct SwitchCore* core = SwitchCore_new(logger, alloc, NULL);
+
+    struct Endpoint eps[ENDPOINTS];
+    for (int i = 0; i < ENDPOINTS; i++) {
+        Bits_memset(&eps[i], 0, sizeof(struct Endpoint));
+        eps[i].iface.send = receiveMessage;
+        eps[i].index = i;
+        Assert_true(!SwitchCore_addInterface(core, &eps[i].iface, alloc, &eps[i].label));
+    }
+
+    // Single-message path: endpoint 0 sends to endpoint 2.
+    Assert_true(!Iface_send(&eps[0].iface, mkMessage(eps[2].label, 0xffff, 1, alloc)));
+    Assert_true(ctx.arrivalCount == 1);
+    Assert_true(ctx.arrivedAt[0] == 2 && ctx.marker[0] == 1);
+
+    // Vector path: a mixed batch from endpoint 0, bulk and classed interleaved
+    // across two destinations. markers 10..15.
+    struct Message* batch[6] = {
+        mkMessage(eps[1].label, 0xffff, 10, alloc), // bulk    -> 1
+        mkMessage(eps[2].label, 7,      11, alloc), // classed -> 2
+        mkMessage(eps[2].label, 0xffff, 12, alloc), // bulk    -> 2
+        mkMessage(eps[1].label, 7,      13, alloc), // classed -> 1
+        mkMessage(eps[1].label, 0xffff, 14, alloc), // bulk    -> 1
+        mkMessage(eps[2].label, 7,      15, alloc), // classed -> 2
+    };
+    int first = ctx.arrivalCount;
+    Assert_true(!SwitchCore_receiveMessageVec(batch, 6, eps[0].iface.connectedIf));
+    Assert_true(ctx.arrivalCount == first + 6);
+
+    int classedSeen = 0;
+    int bulkSeen = 0;
+    for (int i = first; i < ctx.arrivalCount; i++) {
+        uint8_t m = ctx.marker[i];
+        int expectedDest = (m == 11 || m == 12 || m == 15) ? 2 : 1;
+        Assert_true(ctx.arrivedAt[i] == expectedDest);
+        if (m == 11 || m == 13 || m == 15) {
+            // classed traffic must clear the batch before any bulk
+            Assert_true(!bulkSeen);
+            classedSeen++;
+        } else {
+            Assert_true(classedSeen == 3);
+            bulkSeen++;
+        }
+    }
+    Assert_true(classedSeen == 3 && bulkSeen == 3);
+
+    // The vector path must rewrite headers exactly like the single path:
+    // send identical bulk messages both ways and compare the arrived bytes.
+    int a = ctx.arrivalCount;
+    Assert_true(!Iface_send(&eps[0].iface, mkMessage(eps[1].label, 0xffff, 20, alloc)));
+    struct Message* one[1] = { mkMessage(eps[1].label, 0xffff, 21, alloc) };
+    Assert_true(!SwitchCore_receiveMessageVec(one, 1, eps[0].iface.connectedIf));
+    Assert_true(ctx.arrivalCount == a + 2);
+    Assert_true(!Bits_memcmp(ctx.headerBytes[a], ctx.headerBytes[a + 1], SwitchHeader_SIZE));
+
+    // A message for a vacant interface comes back to the sender as an error.
+    int b = ctx.arrivalCount;
+    uint32_t vacantBits = NumberCompress_bitsUsedForNumber(ENDPOINTS + 2);
+    uint64_t vacantLabel =
+        NumberCompress_getCompressed(ENDPOINTS + 2, vacantBits) | (1 << vacantBits);
+    struct Message* bad[1] = { mkMessage(vacantLabel, 0xffff, 30, alloc) };
+    Assert_true(!SwitchCore_receiveMessageVec(bad, 1, eps[0].iface.connectedIf));
+    Assert_true(ctx.arrivalCount == b + 1);
+    Assert_true(ctx.arrivedAt[b] == 0);
+
+    printf("SwitchCore vector path ok\n");
+    Allocator_free(alloc);
+    return 0;
+}
@@ -29,6 +29,8 @@
 #include "interface/tuntap/TUNMessageType.h"
 #include "util/Hex.h"
 #include "util/events/Time.h"
+
+#include <stdlib.h>
 #include "util/events/Timeout.h"
 
 #include <stdio.h>
@@ -237,6 +239,29 @@ static void runTest(struct TwoNodes* tn)
     sendMessage(tn, "can", tn->nodeB, tn->nodeA);
     sendMessage(tn, "establish", tn->nodeA, tn->nodeB);
 
+    // With the sessions established, push a burst end to end and report the
+    // rate: tun A -> switch -> crypto -> switch -> tun B, the full data
+    // plane. CJDNS_BENCH=<n> scales the burst for real measurements; the
+    // default is small enough to keep the test quick.
+    {
+        int packets = 1000;
+        char* benchEnv = getenv("CJDNS_BENCH");
+        if (benchEnv) {
+            int p = atoi(benchEnv);
+            if (p > 0) { packets = p; }
+        }
+        uint64_t t0 = Time_hrtime();
+        for (int i = 0; i < packets; i++) {
+            sendMessage(tn, "benchmark payload 0123456789abcdef", tn->nodeA, tn->nodeB);
+        }
+        uint64_t t1 = Time_hrtime();
+        uint64_t nsPer = (t1 - t0) / ((packets) ? packets : 1);
+        Log_info(tn->logger, "BENCH: [%d] packets end-to-end, [%llu] ns/packet, [%llu] pps",
+                 packets,
+                 (unsigned long long) nsPer,
+                 (unsigned long long) ((nsPer) ? (1000000000ull / nsPer) : 0));
+    }
+
     Log_debug(tn->logger, "\n\nTest passed, shutting down\n\n");
     Allocator_free(tn->alloc);
 }
@@ -0,0 +1,87 @@
+/* vim: set expandtab ts=4 sw=4: */
+/*
+ * You may redistribute this program and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "dht/dhtcore/VersionList.h"
+#include "memory/MallocAllocator.h"
+#include "switch/EncodingScheme.h"
+#include "util/Assert.h"
+#include "util/Bits.h"
+
+#include <stdint.h>
+
+/**
+ * Golden byte vectors for wire encodings which other nodes parse.
+ * These lock the formats down so an "optimization" of a codec cannot
+ * silently change what goes on the wire: if one of these fails, either
+ * the change broke interop or the protocol is deliberately being revised
+ * (in which case update the vector in the same commit that revises it).
+ */
+
+static void schemeGoldens()
+{
+    struct Allocator* alloc = MallocAllocator_new(1 << 20);
+
+    struct EncodingScheme_Form forms[3] = {
+        { .bitCount = 3, .prefixLen = 1, .prefix = 1, },
+        { .bitCount = 5, .prefixLen = 2, .prefix = 1 << 1, },
+        { .bitCount = 8, .prefixLen = 2, .prefix = 0, }
+    };
+    struct EncodingScheme* v358 = EncodingScheme_defineDynWidthScheme(forms, 3, alloc);
+    String* ser = EncodingScheme_serialize(v358, alloc);
+    Assert_true(ser->len == 5);
+    Assert_true(!Bits_memcmp(ser->bytes, "\x61\x14\x45\x81\x00", 5));
+
+    struct EncodingScheme* f8 = EncodingScheme_defineFixedWidthScheme(8, alloc);
+    String* ser8 = EncodingScheme_serialize(f8, alloc);
+    Assert_true(ser8->len == 2);
+    Assert_true(!Bits_memcmp(ser8->bytes, "\x00\x01", 2));
+
+    // and the serialized form must parse back to an identical scheme
+    struct EncodingScheme* reparsed = EncodingScheme_deserialize(ser, alloc);
+    Assert_true(reparsed && !EncodingScheme_compare(v358, reparsed));
+
+    Allocator_free(alloc);
+}
+
+static void versionListGoldens()
+{
+    struct Allocator* alloc = MallocAllocator_new(1 << 20);
+
+    struct VersionList* vl = VersionList_new(3, alloc);
+    vl->versions[0] = 19;
+    vl->versions[1] = 20;
+    vl->versions[2] = 21;
+    String* ser = VersionList_stringify(vl, alloc);
+    Assert_true(ser->len == 4);
+    Assert_true(!Bits_memcmp(ser->bytes, "\x01\x13\x14\x15", 4));
+
+    // two-byte width when any version needs it
+    vl->versions[1] = 300;
+    String* ser2 = VersionList_stringify(vl, alloc);
+    Assert_true(ser2->len == 7);
+    Assert_true(!Bits_memcmp(ser2->bytes, "\x02\x00\x13\x01\x2c\x00\x15", 7));
+
+    struct VersionList* back = VersionList_parse(ser2, alloc);
+    Assert_true(back && back->length == 3);
+    Assert_true(back->versions[0] == 19 && back->versions[1] == 300 && back->versions[2] == 21);
+
+    Allocator_free(alloc);
+}
+
+int main()
+{
+    schemeGoldens();
+    versionListGoldens();
+    return 0;
+}
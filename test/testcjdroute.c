@@ -24,8 +24,12 @@
 #include "util/Js.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <unistd.h>
 #include <fcntl.h>
+#ifndef win32
+#include <sys/wait.h>
+#endif
 
 #ifdef SUBNODE
     #define testcjdroute_SUBNODE 1
@@ -168,6 +172,20 @@ static uint64_t runFuzzTestManual(
                 &seventySpaces[count],
                 (int)((now - startTime)/1000000),
                 (int)((now - startTime)/1000)%1000);
+
+        // Corpus cases are also a performance regression net: a case which
+        // suddenly takes orders of magnitude longer than its peers means an
+        // algorithmic blowup somewhere in the parse path. Tune with
+        // CJDNS_FUZZ_SLOW_MS, 0 disables.
+        uint64_t slowMs = 200;
+        char* slowEnv = getenv("CJDNS_FUZZ_SLOW_MS");
+        if (slowEnv) { slowMs = strtoull(slowEnv, NULL, 10); }
+        if (slowMs && (now - startTime) / 1000000 > slowMs) {
+            fprintf(stderr, "SLOW FUZZ CASE [%s] took [%d]ms (limit [%d]ms)\n",
+                    testCase,
+                    (int)((now - startTime)/1000000),
+                    (int)slowMs);
+        }
         return now;
     }
     return startTime;
@@ -247,6 +265,45 @@ static int main2(int argc, char** argv, struct Allocator* alloc, struct Random*
         usage(argv[0]);
         return 100;
     }
+    #ifndef win32
+        // CJDNS_TEST_JOBS=<n> splits the whole run across n forked workers;
+        // each worker takes every n-th test so the slices stay balanced, and
+        // a crashing test fails the run through the worker's exit status.
+        char* jobsEnv = getenv("CJDNS_TEST_JOBS");
+        int jobs = (jobsEnv) ? atoi(jobsEnv) : 0;
+        if (jobs > 1) {
+            if (jobs > 64) { jobs = 64; }
+            pid_t pids[64];
+            for (int w = 0; w < jobs; w++) {
+                pid_t pid = fork();
+                Assert_true(pid >= 0);
+                if (!pid) {
+                    for (int i = w; i < TEST_COUNT; i += jobs) {
+                        now = runTest(TESTS[i].func, TESTS[i].name, now, argc, argv, quiet);
+                    }
+                    for (int i = w; i < FUZZ_CASE_COUNT; i += jobs) {
+                        struct Allocator* child = MallocAllocator_new(1<<24);
+                        now = runFuzzTestManual(child, detRand, FUZZ_CASES[i], now, quiet);
+                        Allocator_free(child);
+                    }
+                    exit(0);
+                }
+                pids[w] = pid;
+            }
+            int failed = 0;
+            for (int w = 0; w < jobs; w++) {
+                int status = 0;
+                Assert_true(waitpid(pids[w], &status, 0) == pids[w]);
+                if (!WIFEXITED(status) || WEXITSTATUS(status)) { failed = 1; }
+            }
+            if (!quiet) {
+                fprintf(stderr, "Parallel test run (%d jobs) %s\n",
+                        jobs, (failed) ? "FAILED" : "complete");
+            }
+            return (failed) ? 100 : 0;
+        }
+    #endif
+
     for (int i = 0; i < TEST_COUNT; i++) {
         now = runTest(TESTS[i].func, TESTS[i].name, now, argc, argv, quiet);
     }
@@ -51,6 +51,9 @@ struct IpTunnel_pvt
 
     uint32_t connectionCapacity;
 
+    /** Most-recently matched connection per direction ([0] node, [1] tun). */
+    int lastConnIdx[2];
+
     /** An always incrementing number which represents the connections. */
     uint32_t nextConnectionNumber;
 
@@ -684,12 +687,26 @@ static struct IpTunnel_Connection* findConnection(uint8_t sourceIp6[32],
                                                   bool isFromTun,
                                                   struct IpTunnel_pvt* context)
 {
+    // Flows come in runs for one connection, try the last match first. The
+    // index is re-validated against the packet so a stale hint only misses.
+    const int last = context->lastConnIdx[!!isFromTun];
+    if (last >= 0 && last < (int)context->pub.connectionList.count) {
+        struct IpTunnel_Connection* conn = &context->pub.connectionList.connections[last];
+        if (sourceIp6 && destIp6 && isValidAddress6(sourceIp6, destIp6, isFromTun, conn)) {
+            return conn;
+        }
+        if (sourceIp4 && destIp4 && isValidAddress4(sourceIp4, destIp4, isFromTun, conn)) {
+            return conn;
+        }
+    }
     for (int i = 0; i < (int)context->pub.connectionList.count; i++) {
         struct IpTunnel_Connection* conn = &context->pub.connectionList.connections[i];
         if (sourceIp6 && destIp6 && isValidAddress6(sourceIp6, destIp6, isFromTun, conn)) {
+            context->lastConnIdx[!!isFromTun] = i;
             return conn;
         }
         if (sourceIp4 && destIp4 && isValidAddress4(sourceIp4, destIp4, isFromTun, conn)) {
+            context->lastConnIdx[!!isFromTun] = i;
             return conn;
         }
     }
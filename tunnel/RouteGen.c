@@ -85,6 +85,18 @@ struct RouteGen_pvt
     struct ArrayList_OfPrefix4* localPrefixes4;
     struct ArrayList_OfPrefix4* exceptions4;
 
+    /**
+     * Memoized output of getGeneratedRoutes(), valid until any prefix list
+     * changes. Commit and the dump RPCs both regenerate; with a big
+     * exception list the inversion/merge pass is the expensive part.
+     */
+    struct Allocator* genAlloc;
+    struct Prefix46* genCache;
+
+    /** The set which was last pushed to the kernel, for dry-run diffs. */
+    struct Allocator* committedAlloc;
+    struct Prefix46* committed;
+
     struct Allocator* alloc;
     struct Log* log;
 
@@ -182,6 +194,20 @@ static void addSomething(struct RouteGen_pvt* rp,
         Assert_failure("unexpected addr type");
     }
     rp->pub.hasUncommittedChanges = true;
+    if (rp->genAlloc) {
+        Allocator_free(rp->genAlloc);
+        rp->genAlloc = NULL;
+        rp->genCache = NULL;
+    }
+}
+
+static void invalidateGenerated(struct RouteGen_pvt* rp)
+{
+    if (rp->genAlloc) {
+        Allocator_free(rp->genAlloc);
+        rp->genAlloc = NULL;
+        rp->genCache = NULL;
+    }
 }
 
 void RouteGen_addException(struct RouteGen* rg, struct Sockaddr* destination)
@@ -278,18 +304,21 @@ static bool removeSomething(struct RouteGen_pvt* rp,
 bool RouteGen_removePrefix(struct RouteGen* rg, struct Sockaddr* toRemove)
 {
     struct RouteGen_pvt* rp = Identity_check((struct RouteGen_pvt*) rg);
+    invalidateGenerated(rp);
     return removeSomething(rp, toRemove, rp->prefixes6, rp->prefixes4);
 }
 
 bool RouteGen_removeLocalPrefix(struct RouteGen* rg, struct Sockaddr* toRemove)
 {
     struct RouteGen_pvt* rp = Identity_check((struct RouteGen_pvt*) rg);
+    invalidateGenerated(rp);
     return removeSomething(rp, toRemove, rp->localPrefixes6, rp->localPrefixes4);
 }
 
 bool RouteGen_removeException(struct RouteGen* rg, struct Sockaddr* toRemove)
 {
     struct RouteGen_pvt* rp = Identity_check((struct RouteGen_pvt*) rg);
+    invalidateGenerated(rp);
     return removeSomething(rp, toRemove, rp->exceptions6, rp->exceptions4);
 }
 
@@ -653,8 +682,10 @@ static struct ArrayList_OfPrefix6* genPrefixes6(struct ArrayList_OfPrefix6* pref
     return out;
 }
 
-static struct Prefix46* getGeneratedRoutes(struct RouteGen_pvt* rp, struct Allocator* alloc)
+static struct Prefix46* getGeneratedRoutes(struct RouteGen_pvt* rp)
 {
+    if (rp->genCache) { return rp->genCache; }
+    struct Allocator* alloc = rp->genAlloc = Allocator_child(rp->alloc);
     struct Prefix46* out = Allocator_calloc(alloc, sizeof(struct Prefix46), 1);
     if (rp->prefixes4->length > 0) {
         out->prefix4 = genPrefixes4(rp->prefixes4, rp->exceptions4, rp->localPrefixes4, alloc);
@@ -672,13 +703,14 @@ static struct Prefix46* getGeneratedRoutes(struct RouteGen_pvt* rp, struct Alloc
     } else {
         out->prefix6 = ArrayList_OfPrefix6_new(alloc);
     }
+    rp->genCache = out;
     return out;
 }
 
 Dict* RouteGen_getGeneratedRoutes(struct RouteGen* rg, struct Allocator* alloc)
 {
     struct RouteGen_pvt* rp = Identity_check((struct RouteGen_pvt*) rg);
-    struct Prefix46* p46 = getGeneratedRoutes(rp, alloc);
+    struct Prefix46* p46 = getGeneratedRoutes(rp);
     return getSomething(rp, alloc, p46->prefix6, p46->prefix4);
 }
 
@@ -687,7 +719,7 @@ Er_DEFUN(void RouteGen_commit(struct RouteGen* rg,
                               struct Allocator* tempAlloc))
 {
     struct RouteGen_pvt* rp = Identity_check((struct RouteGen_pvt*) rg);
-    struct Prefix46* p46 = getGeneratedRoutes(rp, tempAlloc);
+    struct Prefix46* p46 = getGeneratedRoutes(rp);
     struct Sockaddr** prefixSet =
         Allocator_calloc(tempAlloc, sizeof(char*), p46->prefix4->length + p46->prefix6->length);
     int prefixNum = 0;
@@ -702,9 +734,120 @@ Er_DEFUN(void RouteGen_commit(struct RouteGen* rg,
     Assert_true(prefixNum == p46->prefix4->length + p46->prefix6->length);
     Er(NetDev_setRoutes(tunName, prefixSet, prefixNum, rp->log, tempAlloc));
     rp->pub.hasUncommittedChanges = false;
+
+    // keep a copy of what the kernel now has, for dry-run diffs
+    if (rp->committedAlloc) { Allocator_free(rp->committedAlloc); }
+    struct Allocator* ca = rp->committedAlloc = Allocator_child(rp->alloc);
+    struct Prefix46* committed = Allocator_calloc(ca, sizeof(struct Prefix46), 1);
+    committed->prefix4 = ArrayList_OfPrefix4_new(ca);
+    committed->prefix6 = ArrayList_OfPrefix6_new(ca);
+    for (int i = 0; i < p46->prefix4->length; i++) {
+        ArrayList_OfPrefix4_add(committed->prefix4,
+            clonePrefix4(ArrayList_OfPrefix4_get(p46->prefix4, i), ca));
+    }
+    for (int i = 0; i < p46->prefix6->length; i++) {
+        ArrayList_OfPrefix6_add(committed->prefix6,
+            clonePrefix6(ArrayList_OfPrefix6_get(p46->prefix6, i), ca));
+    }
+    rp->committed = committed;
     Er_ret();
 }
 
+static bool samePrefix4(struct Prefix4* a, struct Prefix4* b)
+{
+    return !comparePrefixes4(a, b);
+}
+
+static bool samePrefix6(struct Prefix6* a, struct Prefix6* b)
+{
+    return !comparePrefixes6(a, b);
+}
+
+/** Cap each diff list so the response always fits down the admin pipe. */
+#define DRY_RUN_MAX 128
+
+Dict* RouteGen_dryRun(struct RouteGen* rg, struct Allocator* alloc)
+{
+    struct RouteGen_pvt* rp = Identity_check((struct RouteGen_pvt*) rg);
+    struct Prefix46* gen = getGeneratedRoutes(rp);
+
+    List* add = List_new(alloc);
+    List* remove = List_new(alloc);
+    int addCount = 0;
+    int removeCount = 0;
+    int truncated = 0;
+
+    for (int i = 0; i < gen->prefix4->length; i++) {
+        struct Prefix4* pfx = ArrayList_OfPrefix4_get(gen->prefix4, i);
+        bool have = false;
+        for (int j = 0; rp->committed && j < rp->committed->prefix4->length; j++) {
+            if (samePrefix4(pfx, ArrayList_OfPrefix4_get(rp->committed->prefix4, j))) {
+                have = true;
+                break;
+            }
+        }
+        if (!have) {
+            if (addCount++ < DRY_RUN_MAX) { List_addString(add, printPrefix4(alloc, pfx), alloc); }
+            else { truncated = 1; }
+        }
+    }
+    for (int i = 0; i < gen->prefix6->length; i++) {
+        struct Prefix6* pfx = ArrayList_OfPrefix6_get(gen->prefix6, i);
+        bool have = false;
+        for (int j = 0; rp->committed && j < rp->committed->prefix6->length; j++) {
+            if (samePrefix6(pfx, ArrayList_OfPrefix6_get(rp->committed->prefix6, j))) {
+                have = true;
+                break;
+            }
+        }
+        if (!have) {
+            if (addCount++ < DRY_RUN_MAX) { List_addString(add, printPrefix6(alloc, pfx), alloc); }
+            else { truncated = 1; }
+        }
+    }
+    for (int j = 0; rp->committed && j < rp->committed->prefix4->length; j++) {
+        struct Prefix4* pfx = ArrayList_OfPrefix4_get(rp->committed->prefix4, j);
+        bool have = false;
+        for (int i = 0; i < gen->prefix4->length; i++) {
+            if (samePrefix4(pfx, ArrayList_OfPrefix4_get(gen->prefix4, i))) {
+                have = true;
+                break;
+            }
+        }
+        if (!have) {
+            if (removeCount++ < DRY_RUN_MAX) {
+                List_addString(remove, printPrefix4(alloc, pfx), alloc);
+            } else { truncated = 1; }
+        }
+    }
+    for (int j = 0; rp->committed && j < rp->committed->prefix6->length; j++) {
+        struct Prefix6* pfx = ArrayList_OfPrefix6_get(rp->committed->prefix6, j);
+        bool have = false;
+        for (int i = 0; i < gen->prefix6->length; i++) {
+            if (samePrefix6(pfx, ArrayList_OfPrefix6_get(gen->prefix6, i))) {
+                have = true;
+                break;
+            }
+        }
+        if (!have) {
+            if (removeCount++ < DRY_RUN_MAX) {
+                List_addString(remove, printPrefix6(alloc, pfx), alloc);
+            } else { truncated = 1; }
+        }
+    }
+
+    Dict* out = Dict_new(alloc);
+    Dict_putListC(out, "add", add, alloc);
+    Dict_putListC(out, "remove", remove, alloc);
+    Dict_putIntC(out, "addCount", addCount, alloc);
+    Dict_putIntC(out, "removeCount", removeCount, alloc);
+    if (truncated) {
+        Dict_putIntC(out, "truncated", 1, alloc);
+    }
+    Dict_putIntC(out, "uncommitted", rp->pub.hasUncommittedChanges, alloc);
+    return out;
+}
+
 static void setupDefaultLocalPrefixes(struct RouteGen_pvt* rp)
 {
     struct Sockaddr_storage ss;
@@ -39,6 +39,13 @@ Er_DEFUN(void RouteGen_commit(struct RouteGen* rg,
                               const char* tunName,
                               struct Allocator* tempAlloc));
 
+/**
+ * Compute what a commit would change without touching the kernel: lists of
+ * prefixes which would be added and removed relative to the last committed
+ * set (everything counts as an add before the first commit).
+ */
+Dict* RouteGen_dryRun(struct RouteGen* rg, struct Allocator* alloc);
+
 Dict* RouteGen_getPrefixes(struct RouteGen* rg, struct Allocator* alloc);
 
 Dict* RouteGen_getLocalPrefixes(struct RouteGen* rg, struct Allocator* alloc);
@@ -170,6 +170,17 @@ ADD_REMOVE_SOMETHING(removeException, addRemoveSomething_What_RM_EXCEPTION)
             { .name = "route", .required = 1, .type = "String" },                               \
         }), admin)
 
+static void dryRun(Dict* args,
+                   void* vcontext,
+                   String* txid,
+                   struct Allocator* requestAlloc)
+{
+    struct RouteGen_admin_Ctx* const ctx = Identity_check((struct RouteGen_admin_Ctx*) vcontext);
+    Dict* const ret = RouteGen_dryRun(ctx->rg, requestAlloc);
+    Dict_putStringCC(ret, "error", "none", requestAlloc);
+    Admin_sendMessage(ret, txid, ctx->admin);
+}
+
 static void commit(Dict* args,
                    void* vcontext,
                    String* txid,
@@ -208,6 +219,8 @@ void RouteGen_admin_register(struct RouteGen* rg, struct Admin* admin, struct Al
     REGISTER_ADD_REMOVE_SOMETHING(removeLocalPrefix, ctx, admin);
     REGISTER_ADD_REMOVE_SOMETHING(removeException, ctx, admin);
 
+    Admin_registerFunction("RouteGen_dryRun", dryRun, ctx, true, NULL, admin);
+
     Admin_registerFunction("RouteGen_commit", commit, ctx, true,
         ((struct Admin_FunctionArg[]) {
             { .name = "tunName", .required = 1, .type = "String" },
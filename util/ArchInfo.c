@@ -168,3 +168,34 @@ char* ArchInfo_getArchStr(void)
 {
     return ARCHSTR;
 }
+
+#if defined(linux) && (defined(__arm__) || defined(__aarch64__))
+    #include <sys/auxv.h>
+#endif
+
+uint32_t ArchInfo_getFeatures(void)
+{
+    static uint32_t features = UINT32_MAX;
+    if (features != UINT32_MAX) { return features; }
+    uint32_t out = 0;
+
+    #if defined(__x86_64__) || defined(__i386__)
+        if (__builtin_cpu_supports("sse2")) { out |= ArchInfo_Feature_SSE2; }
+        if (__builtin_cpu_supports("ssse3")) { out |= ArchInfo_Feature_SSSE3; }
+        if (__builtin_cpu_supports("avx2")) { out |= ArchInfo_Feature_AVX2; }
+        if (__builtin_cpu_supports("aes")) { out |= ArchInfo_Feature_AES; }
+    #elif defined(__aarch64__)
+        // NEON (asimd) is architectural on aarch64
+        out |= ArchInfo_Feature_NEON;
+        #if defined(linux) && defined(HWCAP_AES)
+            if (getauxval(AT_HWCAP) & HWCAP_AES) { out |= ArchInfo_Feature_AES; }
+        #endif
+    #elif defined(__arm__)
+        #if defined(linux) && defined(HWCAP_NEON)
+            if (getauxval(AT_HWCAP) & HWCAP_NEON) { out |= ArchInfo_Feature_NEON; }
+        #endif
+    #endif
+
+    features = out;
+    return features;
+}
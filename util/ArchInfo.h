@@ -22,6 +22,18 @@ Linker_require("util/ArchInfo.c")
 
 uint32_t ArchInfo_getAuditArch(void);
 
+/**
+ * Runtime CPU feature probe for selecting vectorized/hardware kernels.
+ * The result is detected once and cached; on platforms with no detection
+ * support the answer is zero and callers take their scalar paths.
+ */
+#define ArchInfo_Feature_SSE2  (1u << 0)
+#define ArchInfo_Feature_SSSE3 (1u << 1)
+#define ArchInfo_Feature_AVX2  (1u << 2)
+#define ArchInfo_Feature_AES   (1u << 3)
+#define ArchInfo_Feature_NEON  (1u << 4)
+uint32_t ArchInfo_getFeatures(void);
+
 char* ArchInfo_getArchStr(void);
 
 #endif
@@ -60,15 +60,22 @@ uint32_t AverageRoller_updateAtTime(struct AverageRoller* averageRoller,
     uint32_t index =
         (now - roller->lastUpdateTime + roller->lastUpdateIndex) % roller->windowSeconds;
 
+    const uint32_t bucket = Bits_log2x64(newEntry | 1);
     if (((uint32_t) now) > roller->lastUpdateTime) {
         roller->sum -= roller->seconds[index].sum;
         roller->entryCount -= roller->seconds[index].entryCount;
+        for (int i = 0; i < AverageRoller_BUCKET_COUNT; i++) {
+            roller->totalBuckets[i] -= roller->seconds[index].buckets[i];
+            roller->seconds[index].buckets[i] = 0;
+        }
         roller->seconds[index].sum = newEntry;
         roller->seconds[index].entryCount = 1;
     } else {
         roller->seconds[index].sum += newEntry;
         roller->seconds[index].entryCount++;
     }
+    roller->seconds[index].buckets[bucket]++;
+    roller->totalBuckets[bucket]++;
     roller->sum += newEntry;
     roller->entryCount++;
     roller->average = roller->sum / roller->entryCount;
@@ -86,3 +93,21 @@ uint32_t AverageRoller_update(struct AverageRoller* averageRoller, const uint32_
                                       Time_currentTimeSeconds(),
                                       newEntry);
 }
+
+/** @see AverageRoller.h */
+uint32_t AverageRoller_getPercentile(struct AverageRoller* averageRoller, uint32_t percentile)
+{
+    struct AverageRoller_pvt* roller = Identity_check((struct AverageRoller_pvt*) averageRoller);
+    if (!roller->entryCount) { return 0; }
+    if (percentile > 100) { percentile = 100; }
+    const uint64_t needed = ((uint64_t) roller->entryCount * percentile + 99) / 100;
+    uint64_t seen = 0;
+    for (int b = 0; b < AverageRoller_BUCKET_COUNT; b++) {
+        seen += roller->totalBuckets[b];
+        if (seen >= needed) {
+            // upper bound of the winning bucket
+            return (b >= 31) ? UINT32_MAX : ((2u << b) - 1);
+        }
+    }
+    return UINT32_MAX;
+}
@@ -70,4 +70,19 @@ uint32_t AverageRoller_updateAtTime(struct AverageRoller* averageRoller,
  */
 uint32_t AverageRoller_update(struct AverageRoller* roller, const uint32_t newEntry);
 
+/** Entries are bucketed by log2 magnitude for the percentile estimate. */
+#define AverageRoller_BUCKET_COUNT 32
+
+/**
+ * Estimate a percentile over the same window the average covers.
+ * Entries are counted into log2-magnitude buckets on update, so the answer
+ * costs a fixed scan over 32 counters and is accurate to within a factor of
+ * two (the upper bound of the winning bucket is returned).
+ *
+ * @param roller the roller context created by AverageRoller_new()
+ * @param percentile which percentile, 0 to 100.
+ * @return the estimated value, 0 when the window holds no entries.
+ */
+uint32_t AverageRoller_getPercentile(struct AverageRoller* roller, uint32_t percentile);
+
 #endif
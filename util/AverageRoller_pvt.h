@@ -28,6 +28,9 @@ struct AverageRoller_SumAndEntryCount
 
     /** Number of entries. */
     uint32_t entryCount;
+
+    /** Entries by log2 magnitude, for the percentile estimate. */
+    uint32_t buckets[AverageRoller_BUCKET_COUNT];
 };
 
 /**
@@ -56,6 +59,9 @@ struct AverageRoller_pvt
     /** A stored value equal to the sum divided by the entry count. */
     uint32_t average;
 
+    /** Window-wide totals of the per-second buckets. */
+    uint32_t totalBuckets[AverageRoller_BUCKET_COUNT];
+
     /** Means of getting the current time. */
     struct EventBase* eventBase;
 
@@ -0,0 +1,50 @@
+/* vim: set expandtab ts=4 sw=4: */
+/*
+ * You may redistribute this program and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef Cycles_H
+#define Cycles_H
+
+#include "util/events/Time.h"
+
+#include <stdint.h>
+
+/**
+ * Read the CPU's own cycle/tick counter for cheap hot-path sampling.
+ * This is a raw hardware read: it is not serialized against out-of-order
+ * execution and the unit is ticks of whatever clock the hardware exposes
+ * (TSC on x86, the generic counter on aarch64), so it is only meaningful
+ * as a delta between two nearby reads on the same core. Falls back to
+ * Time_hrtime() where no counter is available.
+ */
+static inline uint64_t Cycles_now(void)
+{
+    #if defined(__x86_64__)
+        uint32_t lo;
+        uint32_t hi;
+        __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+        return ((uint64_t)hi << 32) | lo;
+    #elif defined(__i386__)
+        uint64_t out;
+        __asm__ __volatile__ ("rdtsc" : "=A" (out));
+        return out;
+    #elif defined(__aarch64__)
+        uint64_t out;
+        __asm__ __volatile__ ("mrs %0, cntvct_el0" : "=r" (out));
+        return out;
+    #else
+        return Time_hrtime();
+    #endif
+}
+
+#endif
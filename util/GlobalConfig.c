@@ -15,13 +15,33 @@
 #include "util/GlobalConfig.h"
 #include "util/Identity.h"
 
+#define MAX_CHANGE_HANDLERS 8
+
 struct GlobalConfig_pvt {
     struct GlobalConfig pub;
     String* tunName;
+
+    /** Owns the current tunName, swapped out when the name changes. */
+    struct Allocator* tunNameAlloc;
+
+    /** Subscribers poked whenever a value changes, see GlobalConfig_onChange(). */
+    struct {
+        GlobalConfig_ChangeHandler cb;
+        void* ctx;
+    } changeHandlers[MAX_CHANGE_HANDLERS];
+    int changeHandlerCount;
+
     struct Allocator* alloc;
     Identity
 };
 
+static void fireChange(struct GlobalConfig_pvt* ctx)
+{
+    for (int i = 0; i < ctx->changeHandlerCount; i++) {
+        ctx->changeHandlers[i].cb(&ctx->pub, ctx->changeHandlers[i].ctx);
+    }
+}
+
 String* GlobalConfig_getTunName(struct GlobalConfig* conf)
 {
     struct GlobalConfig_pvt* ctx = Identity_check((struct GlobalConfig_pvt*) conf);
@@ -31,8 +51,23 @@ String* GlobalConfig_getTunName(struct GlobalConfig* conf)
 void GlobalConfig_setTunName(struct GlobalConfig* conf, String* name)
 {
     struct GlobalConfig_pvt* ctx = Identity_check((struct GlobalConfig_pvt*) conf);
-    // This is a memory leak but hopefully this function doesn't get called too much...
-    ctx->tunName = String_clone(name, ctx->alloc);
+    // Readers never retain the string (everything runs on the loop and copies
+    // what it keeps), so the old name can be released when it is replaced.
+    struct Allocator* oldAlloc = ctx->tunNameAlloc;
+    ctx->tunNameAlloc = Allocator_child(ctx->alloc);
+    ctx->tunName = String_clone(name, ctx->tunNameAlloc);
+    if (oldAlloc) { Allocator_free(oldAlloc); }
+    fireChange(ctx);
+}
+
+int GlobalConfig_onChange(struct GlobalConfig* conf, GlobalConfig_ChangeHandler cb, void* cbCtx)
+{
+    struct GlobalConfig_pvt* ctx = Identity_check((struct GlobalConfig_pvt*) conf);
+    if (ctx->changeHandlerCount >= MAX_CHANGE_HANDLERS) { return -1; }
+    ctx->changeHandlers[ctx->changeHandlerCount].cb = cb;
+    ctx->changeHandlers[ctx->changeHandlerCount].ctx = cbCtx;
+    ctx->changeHandlerCount++;
+    return 0;
 }
 
 struct GlobalConfig* GlobalConfig_new(struct Allocator* alloc)
@@ -42,6 +42,15 @@ struct GlobalConfig {
 String* GlobalConfig_getTunName(struct GlobalConfig* conf);
 void GlobalConfig_setTunName(struct GlobalConfig* conf, String* name);
 
+/**
+ * Be poked whenever a value changes, so modules caching derived state
+ * (broadcast address lists, routes to the tun) can refresh instead of
+ * polling. Values read inside the callback are valid for the duration of
+ * the callback; copy anything which must be kept.
+ */
+typedef void (* GlobalConfig_ChangeHandler)(struct GlobalConfig* conf, void* ctx);
+int GlobalConfig_onChange(struct GlobalConfig* conf, GlobalConfig_ChangeHandler cb, void* ctx);
+
 struct GlobalConfig* GlobalConfig_new(struct Allocator* alloc);
 
 #endif
\ No newline at end of file
@@ -17,14 +17,31 @@
 
 #include <stdint.h>
 
-/** The DJB2a hash (equivilant to DJB2 but using XOR instead of +) */
+/**
+ * Word-wise mix hash. Keys here are sockaddrs and ip6 addresses hashed per
+ * packet; folding eight bytes per step with a multiply-xorshift avalanche
+ * has a far shorter dependency chain than the old byte-wise djb2a. Only
+ * used in-process (maps, jitter), never on the wire or on disk.
+ */
 static uint32_t Hash_compute(uint8_t* str, int length)
 {
-    uint32_t hash = 5381;
-    for (int i = 0; i < length; i++) {
-        hash = ((hash << 5) + hash) ^ str[i];
+    uint64_t hash = 0x9e3779b97f4a7c15ull ^ (uint64_t)(uint32_t)length;
+    int i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t chunk;
+        __builtin_memcpy(&chunk, &str[i], 8);
+        hash ^= chunk;
+        hash *= 0xff51afd7ed558ccdull;
+        hash ^= hash >> 32;
+    }
+    uint64_t tail = 0;
+    for (int shift = 0; i < length; i++, shift += 8) {
+        tail |= ((uint64_t)str[i]) << shift;
     }
-    return hash;
+    hash ^= tail;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 32;
+    return (uint32_t)hash;
 }
 
 #endif
@@ -17,7 +17,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-static const uint8_t numForAscii[] =
+// covers the full byte range so decode needs no high-bit branch
+static const uint8_t numForAscii[256] =
 {
     99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,
     99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,
@@ -27,6 +28,14 @@ static const uint8_t numForAscii[] =
     99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,
     99,10,11,12,13,14,15,99,99,99,99,99,99,99,99,99,
     99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,
+    99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,
+    99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,
+    99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,
+    99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,
+    99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,
+    99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,
+    99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,
+    99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,99,
 };
 
 static const char* hexEntities = "0123456789abcdef";
@@ -42,9 +51,17 @@ int Hex_encode(uint8_t* output,
         output[inputLength * 2] = '\0';
     }
 
+    // one 256-entry pair table write per byte instead of two nibble lookups
+    static char hexPairs[256][2];
+    if (!hexPairs[1][1]) {
+        for (int b = 0; b < 256; b++) {
+            hexPairs[b][0] = hexEntities[b >> 4];
+            hexPairs[b][1] = hexEntities[b & 15];
+        }
+    }
     for (uint32_t i = 0; i < inputLength; i++) {
-        output[i * 2] = hexEntities[in[i] >> 4];
-        output[i * 2 + 1] = hexEntities[in[i] & 15];
+        output[i * 2] = hexPairs[in[i]][0];
+        output[i * 2 + 1] = hexPairs[in[i]][1];
     }
 
     return inputLength * 2;
@@ -52,9 +69,6 @@ int Hex_encode(uint8_t* output,
 
 int Hex_decodeByte(const uint8_t highNibble, const uint8_t lowNibble)
 {
-    if ((highNibble & 0x80) | (lowNibble & 0x80)) {
-        return -1;
-    }
     int high = numForAscii[highNibble];
     int low = numForAscii[lowNibble];
     return (high + low < 31) ? (high << 4) | low : -1;
@@ -63,6 +63,15 @@ struct Map_CONTEXT
     #ifdef Map_ENABLE_KEYS
         uint32_t* hashCodes;
         Map_KEY_TYPE* keys;
+
+        /**
+         * Open-addressed index over the dense arrays: each slot holds a dense
+         * index + 1 (0 means empty). Rebuilt lazily whenever it goes stale
+         * (slotIndexCapacity == 0), which removal and overload cause, so the
+         * dense layout, iteration order and handle logic are all unchanged.
+         */
+        uint32_t* slotIndex;
+        uint32_t slotIndexCapacity;
     #endif
 
     #ifdef Map_ENABLE_HANDLES
@@ -85,15 +94,35 @@ static inline struct Map_CONTEXT* Map_FUNCTION(new)(struct Allocator* allocator)
     }));
 }
 
+#ifdef Map_ENABLE_KEYS
+static inline void Map_FUNCTION(rebuildIndex)(struct Map_CONTEXT* map)
+{
+    uint32_t cap = 16;
+    while (cap < map->count * 2) { cap <<= 1; }
+    if (cap != map->slotIndexCapacity) {
+        map->slotIndex =
+            Allocator_realloc(map->allocator, map->slotIndex, cap * sizeof(uint32_t));
+    }
+    map->slotIndexCapacity = cap;
+    Bits_memset(map->slotIndex, 0, cap * sizeof(uint32_t));
+    for (uint32_t i = 0; i < map->count; i++) {
+        uint32_t probe = map->hashCodes[i] & (cap - 1);
+        while (map->slotIndex[probe]) { probe = (probe + 1) & (cap - 1); }
+        map->slotIndex[probe] = i + 1;
+    }
+}
+
 /**
- * This is a very hot loop,
- * a large amount of code relies on this being fast so it is a good target for optimization.
+ * This is a very hot path: steady state is one table probe, the linear layout
+ * is only re-walked indirectly when the lazy index gets rebuilt.
  */
-#ifdef Map_ENABLE_KEYS
 static inline int Map_FUNCTION(indexForKey)(Map_KEY_TYPE* key, struct Map_CONTEXT* map)
 {
-    uint32_t hashCode = (Map_FUNCTION(hash)(key));
-    for (uint32_t i = 0; i < map->count; i++) {
+    if (!map->slotIndexCapacity) { Map_FUNCTION(rebuildIndex)(map); }
+    const uint32_t hashCode = (Map_FUNCTION(hash)(key));
+    const uint32_t mask = map->slotIndexCapacity - 1;
+    for (uint32_t probe = hashCode & mask; map->slotIndex[probe]; probe = (probe + 1) & mask) {
+        const uint32_t i = map->slotIndex[probe] - 1;
         if (map->hashCodes[i] == hashCode
             && Map_FUNCTION(compare)(key, &map->keys[i]) == 0)
         {
@@ -157,9 +186,16 @@ static inline int Map_FUNCTION(remove)(int index, struct Map_CONTEXT* map)
             Bits_memcpy(&map->keys[index], &map->keys[map->count], sizeof(Map_KEY_TYPE));
             Bits_memcpy(&map->values[index], &map->values[map->count], sizeof(Map_VALUE_TYPE));
         #endif
+        #ifdef Map_ENABLE_KEYS
+            // dense indexes moved, the lookup index is stale
+            map->slotIndexCapacity = 0;
+        #endif
         return 0;
     } else if (index == (int) map->count - 1) {
         map->count--;
+        #ifdef Map_ENABLE_KEYS
+            map->slotIndexCapacity = 0;
+        #endif
         return 0;
     }
     return -1;
@@ -212,6 +248,15 @@ static inline int Map_FUNCTION(put)(Map_VALUE_TYPE* value,
         #ifdef Map_ENABLE_KEYS
             map->hashCodes[i] = (Map_FUNCTION(hash)(key));
             Bits_memcpy(&map->keys[i], key, sizeof(Map_KEY_TYPE));
+            if (map->slotIndexCapacity && map->count * 2 <= map->slotIndexCapacity) {
+                const uint32_t mask = map->slotIndexCapacity - 1;
+                uint32_t probe = map->hashCodes[i] & mask;
+                while (map->slotIndex[probe]) { probe = (probe + 1) & mask; }
+                map->slotIndex[probe] = i + 1;
+            } else {
+                // overloaded, force a bigger rebuild on the next lookup
+                map->slotIndexCapacity = 0;
+            }
         #endif
     }
 
@@ -0,0 +1,93 @@
+/* vim: set expandtab ts=4 sw=4: */
+/*
+ * You may redistribute this program and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "util/Metrics.h"
+#include "util/CString.h"
+#include "util/Identity.h"
+
+#define MAX_METRICS 256
+
+struct Metrics_Entry
+{
+    const char* name;
+    uint64_t counter;
+    Metrics_ReadFn read;
+    void* readCtx;
+};
+
+struct Metrics
+{
+    struct Metrics_Entry entries[MAX_METRICS];
+    int count;
+    struct Allocator* alloc;
+    Identity
+};
+
+struct Metrics* Metrics_new(struct Allocator* alloc)
+{
+    struct Metrics* out = Allocator_calloc(alloc, sizeof(struct Metrics), 1);
+    out->alloc = alloc;
+    Identity_set(out);
+    return out;
+}
+
+static struct Metrics_Entry* getEntry(struct Metrics* metrics, const char* name)
+{
+    for (int i = 0; i < metrics->count; i++) {
+        if (!CString_strcmp(metrics->entries[i].name, name)) {
+            return &metrics->entries[i];
+        }
+    }
+    if (metrics->count >= MAX_METRICS) { return NULL; }
+    struct Metrics_Entry* e = &metrics->entries[metrics->count++];
+    e->name = CString_strdup(name, metrics->alloc);
+    return e;
+}
+
+uint64_t* Metrics_counter(struct Metrics* metrics, const char* name)
+{
+    Identity_check(metrics);
+    static uint64_t devnull;
+    struct Metrics_Entry* e = getEntry(metrics, name);
+    return (e) ? &e->counter : &devnull;
+}
+
+void Metrics_registerGauge(struct Metrics* metrics,
+                           const char* name,
+                           Metrics_ReadFn read,
+                           void* ctx)
+{
+    Identity_check(metrics);
+    struct Metrics_Entry* e = getEntry(metrics, name);
+    if (e) {
+        e->read = read;
+        e->readCtx = ctx;
+    }
+}
+
+int Metrics_count(struct Metrics* metrics)
+{
+    Identity_check(metrics);
+    return metrics->count;
+}
+
+int Metrics_get(struct Metrics* metrics, int num, const char** nameOut, uint64_t* valueOut)
+{
+    Identity_check(metrics);
+    if (num < 0 || num >= metrics->count) { return -1; }
+    struct Metrics_Entry* e = &metrics->entries[num];
+    *nameOut = e->name;
+    *valueOut = (e->read) ? e->read(e->readCtx) : e->counter;
+    return 0;
+}
@@ -0,0 +1,54 @@
+/* vim: set expandtab ts=4 sw=4: */
+/*
+ * You may redistribute this program and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef Metrics_H
+#define Metrics_H
+
+#include "memory/Allocator.h"
+#include "util/Linker.h"
+Linker_require("util/Metrics.c")
+
+#include <stdint.h>
+
+/**
+ * A flat registry of named numbers. Counters are plain uint64 slots owned by
+ * the registry and bumped directly by their subsystem; gauges are read
+ * through a callback at dump time. Always on, no locks, no per-sample cost
+ * beyond the increment itself.
+ */
+struct Metrics;
+
+typedef uint64_t (* Metrics_ReadFn)(void* ctx);
+
+struct Metrics* Metrics_new(struct Allocator* alloc);
+
+/** Get (registering on first use) the counter slot for a name. */
+uint64_t* Metrics_counter(struct Metrics* metrics, const char* name);
+
+/** Register a gauge whose value is read at dump time. */
+void Metrics_registerGauge(struct Metrics* metrics,
+                           const char* name,
+                           Metrics_ReadFn read,
+                           void* ctx);
+
+/** Number of registered metrics. */
+int Metrics_count(struct Metrics* metrics);
+
+/**
+ * Read metric number num.
+ * @return 0 on success, -1 if num is out of range.
+ */
+int Metrics_get(struct Metrics* metrics, int num, const char** nameOut, uint64_t* valueOut);
+
+#endif
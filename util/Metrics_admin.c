@@ -0,0 +1,65 @@
+/* vim: set expandtab ts=4 sw=4: */
+/*
+ * You may redistribute this program and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "admin/Admin.h"
+#include "benc/Dict.h"
+#include "benc/Int.h"
+#include "util/Metrics.h"
+#include "util/Metrics_admin.h"
+#include "util/Identity.h"
+
+struct Context
+{
+    struct Metrics* metrics;
+    struct Admin* admin;
+    Identity
+};
+
+#define ENTRIES_PER_PAGE 64
+static void dump(Dict* args, void* vcontext, String* txid, struct Allocator* requestAlloc)
+{
+    struct Context* ctx = Identity_check((struct Context*) vcontext);
+    int64_t* pageP = Dict_getIntC(args, "page");
+    int i = (pageP) ? *pageP * ENTRIES_PER_PAGE : 0;
+
+    Dict* metrics = Dict_new(requestAlloc);
+    const int total = Metrics_count(ctx->metrics);
+    for (int count = 0; i < total && count < ENTRIES_PER_PAGE; i++, count++) {
+        const char* name = NULL;
+        uint64_t value = 0;
+        if (Metrics_get(ctx->metrics, i, &name, &value)) { break; }
+        Dict_putIntC(metrics, (char*) name, value, requestAlloc);
+    }
+
+    Dict* out = Dict_new(requestAlloc);
+    Dict_putDictC(out, "metrics", metrics, requestAlloc);
+    if (i < total) {
+        Dict_putIntC(out, "more", 1, requestAlloc);
+    }
+    Admin_sendMessage(out, txid, ctx->admin);
+}
+
+void Metrics_admin_register(struct Metrics* metrics, struct Admin* admin, struct Allocator* alloc)
+{
+    struct Context* ctx = Allocator_clone(alloc, (&(struct Context) {
+        .metrics = metrics,
+        .admin = admin
+    }));
+    Identity_set(ctx);
+
+    Admin_registerFunction("Metrics_dump", dump, ctx, false,
+        ((struct Admin_FunctionArg[]) {
+            { .name = "page", .required = 0, .type = "Int" }
+        }), admin);
+}
@@ -24,9 +24,9 @@ struct Ping
 {
     struct Pinger_Ping pub;
     struct Pinger* pinger;
-    struct Timeout* timeout;
     String* data;
     int64_t timeSent;
+    uint64_t deadlineMs;
     uint64_t cookie;
     Pinger_SEND_PING(sendPing);
     Pinger_ON_RESPONSE(onResponse);
@@ -46,10 +46,31 @@ struct Pinger
     struct Log* logger;
     struct Allocator* allocator;
 
+    /**
+     * One shared timeout armed at the earliest outstanding deadline replaces
+     * a timer object per ping; when it fires the due pings are swept and it
+     * is re-armed for the next deadline.
+     */
+    struct Allocator* sweepAlloc;
+    uint64_t sweepDeadline;
+
     /** Make all handles for different pingers wildly different to simplify debugging. */
     uint32_t baseHandle;
 };
 
+static void sweep(void* vPinger);
+
+static void armSweep(struct Pinger* pinger, uint64_t deadlineMs, uint64_t nowMs)
+{
+    if (pinger->sweepDeadline && pinger->sweepDeadline <= deadlineMs) { return; }
+    if (pinger->sweepAlloc) { Allocator_free(pinger->sweepAlloc); }
+    pinger->sweepAlloc = Allocator_child(pinger->allocator);
+    uint64_t delay = (deadlineMs > nowMs) ? deadlineMs - nowMs : 0;
+    // ping timeouts are coarse, let sweeps from different pingers coalesce
+    Timeout_setTimeoutWithSlack(sweep, pinger, delay, 64, pinger->eventBase, pinger->sweepAlloc);
+    pinger->sweepDeadline = deadlineMs;
+}
+
 static void callback(String* data, struct Ping* ping)
 {
     uint32_t now = Time_currentTimeMilliseconds();
@@ -75,6 +96,32 @@ static void timeoutCallback(void* vping)
     callback(NULL, p);
 }
 
+static void sweep(void* vPinger)
+{
+    struct Pinger* pinger = (struct Pinger*) vPinger;
+    pinger->sweepDeadline = 0;
+    if (pinger->sweepAlloc) {
+        Allocator_free(pinger->sweepAlloc);
+        pinger->sweepAlloc = NULL;
+    }
+
+    const uint64_t now = Time_currentTimeMilliseconds();
+    uint64_t nextDeadline = UINT64_MAX;
+    // downward so the shifting caused by removal never skips an unvisited entry
+    for (int i = (int)pinger->outstandingPings.count - 1; i >= 0; i--) {
+        if (i >= (int)pinger->outstandingPings.count) { continue; }
+        struct Ping* p = Identity_check((struct Ping*) pinger->outstandingPings.values[i]);
+        if (p->deadlineMs <= now) {
+            timeoutCallback(p);
+        } else if (p->deadlineMs < nextDeadline) {
+            nextDeadline = p->deadlineMs;
+        }
+    }
+    if (nextDeadline != UINT64_MAX) {
+        armSweep(pinger, nextDeadline, now);
+    }
+}
+
 static int freePing(struct Allocator_OnFreeJob* job)
 {
     struct Ping* p = Identity_check((struct Ping*) job->userData);
@@ -133,8 +180,8 @@ struct Pinger_Ping* Pinger_newPing(String* data,
 
     Allocator_onFree(alloc, freePing, ping);
 
-    ping->timeout =
-        Timeout_setTimeout(timeoutCallback, ping, timeoutMilliseconds, pinger->eventBase, alloc);
+    ping->deadlineMs = ping->timeSent + timeoutMilliseconds;
+    armSweep(pinger, ping->deadlineMs, ping->timeSent);
 
     Timeout_setTimeout(asyncSendPing, ping, 0, pinger->eventBase, alloc);
 
@@ -19,18 +19,29 @@
 #include <stdint.h>
 #include <stddef.h>
 
-static inline void QSort(void* base, size_t members, size_t size,
-                         int (*compar) (const void *, const void *))
-{
-    size_t i, j;
-    size_t gap = members;
-    uintptr_t p1, p2;
-    bool worked;
+/**
+ * Introsort-style generic sort: quicksort with median-of-three pivots and an
+ * insertion sort for small ranges. When the recursion depth indicates
+ * pathological input it falls back to the old combsort, which bounds the
+ * worst case to what the previous implementation did rather than to
+ * n log n. Byte-generic like libc qsort.
+ */
 
-    if (!members) {
-        return;
+static inline void QSort__swap(uint8_t* a, uint8_t* b, size_t size)
+{
+    while (size--) {
+        uint8_t tmp = *a;
+        *a++ = *b;
+        *b++ = tmp;
     }
+}
 
+static inline void QSort__comb(uint8_t* base, size_t members, size_t size,
+                               int (*compar) (const void *, const void *))
+{
+    size_t gap = members;
+    bool worked;
+    if (!members) { return; }
     do {
         gap = (gap * 10) / 13;
         if (gap == 9 || gap == 10) {
@@ -39,27 +50,78 @@ static inline void QSort(void* base, size_t members, size_t size,
             gap = 1;
         }
         worked = false;
-
-        for (i = 0, p1 = (uintptr_t) base; i < members - gap; i++, p1 += size) {
-            j = i + gap;
-            p2 = (uintptr_t) base + j * size;
-            if (compar((void *) p1, (void *) p2) > 0) {
-                int k = size;
-                uint8_t tmp;
-                uint8_t* tp1;
-                uint8_t* tp2;
-
-                tp1 = (uint8_t*) p1;
-                tp2 = (uint8_t*) p2;
-                do {
-                    tmp = *tp1;
-                    *tp1++ = *tp2;
-                    *tp2++ = tmp;
-                } while (--k);
+        for (size_t i = 0; i + gap < members; i++) {
+            uint8_t* p1 = &base[i * size];
+            uint8_t* p2 = &base[(i + gap) * size];
+            if (compar(p1, p2) > 0) {
+                QSort__swap(p1, p2, size);
                 worked = true;
             }
         }
     } while (gap > 1 || worked);
 }
 
+static inline void QSort__insertion(uint8_t* base, size_t members, size_t size,
+                                    int (*compar) (const void *, const void *))
+{
+    for (size_t i = 1; i < members; i++) {
+        for (size_t j = i; j > 0 && compar(&base[(j - 1) * size], &base[j * size]) > 0; j--) {
+            QSort__swap(&base[(j - 1) * size], &base[j * size], size);
+        }
+    }
+}
+
+static inline void QSort__intro(uint8_t* base, size_t members, size_t size,
+                                int (*compar) (const void *, const void *), int depth)
+{
+    while (members > 12) {
+        if (!depth) {
+            QSort__comb(base, members, size, compar);
+            return;
+        }
+        depth--;
+
+        // median of first, middle, last as the pivot, parked at the end
+        uint8_t* first = base;
+        uint8_t* mid = &base[(members / 2) * size];
+        uint8_t* last = &base[(members - 1) * size];
+        if (compar(first, mid) > 0) { QSort__swap(first, mid, size); }
+        if (compar(mid, last) > 0) { QSort__swap(mid, last, size); }
+        if (compar(first, mid) > 0) { QSort__swap(first, mid, size); }
+        QSort__swap(mid, last, size);
+        uint8_t* pivot = last;
+
+        size_t store = 0;
+        for (size_t i = 0; i + 1 < members; i++) {
+            if (compar(&base[i * size], pivot) < 0) {
+                QSort__swap(&base[i * size], &base[store * size], size);
+                store++;
+            }
+        }
+        QSort__swap(&base[store * size], pivot, size);
+
+        // recurse into the smaller side, loop on the larger
+        size_t leftLen = store;
+        size_t rightLen = members - store - 1;
+        if (leftLen < rightLen) {
+            QSort__intro(base, leftLen, size, compar, depth);
+            base = &base[(store + 1) * size];
+            members = rightLen;
+        } else {
+            QSort__intro(&base[(store + 1) * size], rightLen, size, compar, depth);
+            members = leftLen;
+        }
+    }
+    QSort__insertion(base, members, size, compar);
+}
+
+static inline void QSort(void* base, size_t members, size_t size,
+                         int (*compar) (const void *, const void *))
+{
+    if (members < 2) { return; }
+    int depth = 2;
+    for (size_t m = members; m; m >>= 1) { depth += 2; }
+    QSort__intro((uint8_t*) base, members, size, compar, depth);
+}
+
 #endif
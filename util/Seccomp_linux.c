@@ -225,6 +225,17 @@ static Er_DEFUN(struct sock_fprog* mkFilter(struct Allocator* alloc))
             IFEQ(__NR_recvmsg, success),
         #endif
 
+        // udp batching (UDPAddrIface drains/flushes many datagrams per syscall)
+        #ifdef __NR_sendmmsg
+            IFEQ(__NR_sendmmsg, success),
+        #endif
+        #ifdef __NR_recvmmsg
+            IFEQ(__NR_recvmmsg, success),
+        #endif
+        #ifdef __NR_recvmmsg_time64
+            IFEQ(__NR_recvmmsg_time64, success),
+        #endif
+
         // ETHInterface
         #ifdef __NR_sendto
             IFEQ(__NR_sendto, success),
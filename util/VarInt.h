@@ -98,6 +98,21 @@ static inline int VarInt_pop(struct VarInt_Iter* iter, uint64_t* _out)
     return 0;
 }
 
+/**
+ * Decode up to max values in one call.
+ * @return the number decoded (stopping cleanly at the end of the buffer),
+ *         or -1 if a value is truncated or malformed.
+ */
+static inline int VarInt_popBulk(struct VarInt_Iter* iter, uint64_t* out, int max)
+{
+    int n = 0;
+    while (n < max && VarInt_hasMore(iter)) {
+        if (VarInt_pop(iter, &out[n])) { return -1; }
+        n++;
+    }
+    return n;
+}
+
 static inline int VarInt_push(struct VarInt_Iter* iter, uint64_t val)
 {
     uint8_t* ptr = iter->ptr;
@@ -0,0 +1,124 @@
+/* vim: set expandtab ts=4 sw=4: */
+/*
+ * You may redistribute this program and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "util/Watchdog.h"
+#include "util/events/Time.h"
+#include "util/events/Timeout.h"
+#include "util/Identity.h"
+
+#ifndef win32
+
+#include <sys/mman.h>
+#include <signal.h>
+#include <unistd.h>
+#include <stdlib.h>
+
+struct Watchdog
+{
+    /** Shared with the watchdog child, holds the last heartbeat time in ms. */
+    volatile uint64_t* heartbeat;
+    uint32_t timeoutMilliseconds;
+    pid_t childPid;
+    struct Log* logger;
+    Identity
+};
+
+static void beat(void* vWatchdog)
+{
+    struct Watchdog* wd = Identity_check((struct Watchdog*) vWatchdog);
+    *wd->heartbeat = Time_currentTimeMilliseconds();
+}
+
+static int killChildOnFree(struct Allocator_OnFreeJob* job)
+{
+    struct Watchdog* wd = Identity_check((struct Watchdog*) job->userData);
+    if (wd->childPid > 0) {
+        kill(wd->childPid, SIGKILL);
+    }
+    return 0;
+}
+
+static void watchdogMain(volatile uint64_t* heartbeat, uint32_t timeoutMs, pid_t daemonPid)
+{
+    const uint32_t pollMs = (timeoutMs / 4) ? (timeoutMs / 4) : 1;
+    for (;;) {
+        usleep(pollMs * 1000);
+        if (getppid() != daemonPid) {
+            // daemon exited on its own, we're done
+            _exit(0);
+        }
+        uint64_t last = *heartbeat;
+        uint64_t now = Time_currentTimeMilliseconds();
+        if (last && now > last && now - last > timeoutMs) {
+            // the loop is wedged, abort the daemon so it dumps core and restarts
+            kill(daemonPid, SIGABRT);
+            _exit(1);
+        }
+    }
+}
+
+int Watchdog_start(uint32_t timeoutMilliseconds,
+                   struct EventBase* base,
+                   struct Log* logger,
+                   struct Allocator* alloc)
+{
+    volatile uint64_t* heartbeat = mmap(NULL, sizeof(uint64_t), PROT_READ | PROT_WRITE,
+                                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (heartbeat == MAP_FAILED) {
+        Log_warn(logger, "Watchdog mmap() failed");
+        return -1;
+    }
+    *heartbeat = Time_currentTimeMilliseconds();
+
+    pid_t daemonPid = getpid();
+    pid_t child = fork();
+    if (child < 0) {
+        Log_warn(logger, "Watchdog fork() failed");
+        munmap((void*) heartbeat, sizeof(uint64_t));
+        return -1;
+    }
+    if (!child) {
+        watchdogMain(heartbeat, timeoutMilliseconds, daemonPid);
+        _exit(0);
+    }
+
+    struct Watchdog* wd = Allocator_calloc(alloc, sizeof(struct Watchdog), 1);
+    wd->heartbeat = heartbeat;
+    wd->timeoutMilliseconds = timeoutMilliseconds;
+    wd->childPid = child;
+    wd->logger = logger;
+    Identity_set(wd);
+
+    // refresh four times per timeout so scheduler jitter does not false-trip
+    uint32_t beatMs = (timeoutMilliseconds / 4) ? (timeoutMilliseconds / 4) : 1;
+    Timeout_setInterval(beat, wd, beatMs, base, alloc);
+    Allocator_onFree(alloc, killChildOnFree, wd);
+
+    Log_info(logger, "Watchdog started, timeout [%u]ms, pid [%d]",
+             timeoutMilliseconds, (int) child);
+    return 0;
+}
+
+#else // win32
+
+int Watchdog_start(uint32_t timeoutMilliseconds,
+                   struct EventBase* base,
+                   struct Log* logger,
+                   struct Allocator* alloc)
+{
+    Log_warn(logger, "Watchdog is not supported on this platform");
+    return -1;
+}
+
+#endif
@@ -0,0 +1,38 @@
+/* vim: set expandtab ts=4 sw=4: */
+/*
+ * You may redistribute this program and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef Watchdog_H
+#define Watchdog_H
+
+#include "memory/Allocator.h"
+#include "util/events/EventBase.h"
+#include "util/log/Log.h"
+#include "util/Linker.h"
+Linker_require("util/Watchdog.c")
+
+/**
+ * Fork a tiny watchdog process sharing one heartbeat word with the daemon.
+ * The daemon refreshes the heartbeat from a loop timer; if the loop wedges
+ * for longer than timeoutMilliseconds the watchdog SIGABRTs the daemon so
+ * the init system restarts it with a usable core dump instead of a silent
+ * hang. No-op on platforms without fork/mmap.
+ *
+ * @return 0 on success, -1 if the watchdog could not be started.
+ */
+int Watchdog_start(uint32_t timeoutMilliseconds,
+                   struct EventBase* base,
+                   struct Log* logger,
+                   struct Allocator* alloc);
+
+#endif
@@ -17,6 +17,8 @@
 
 #include "memory/Allocator.h"
 #include "util/Linker.h"
+
+#include <stdint.h>
 Linker_require("util/events/libuv/EventBase.c")
 
 typedef struct EventBase
@@ -32,4 +34,27 @@ void EventBase_beginLoop(struct EventBase* eventBase);
 
 void EventBase_endLoop(struct EventBase* eventBase);
 
+/**
+ * Enable busy-poll mode: after each blocking wake the loop spins the given
+ * number of non-blocking passes before sleeping again, trading idle CPU for
+ * burst latency. Zero (the default) disables it. Takes effect the next time
+ * the loop is started.
+ */
+void EventBase_setBusyPoll(struct EventBase* eventBase, int iterations);
+
+/**
+ * Read the event-loop stall tracer.
+ * The tracer is a heartbeat timer; a "stall" is a heartbeat which arrived
+ * more than 100 milliseconds late, meaning some callback held the loop for
+ * at least that long.
+ *
+ * @param stallsOut number of stalls since start, may be NULL.
+ * @param maxStallMsOut longest observed lateness in ms, may be NULL.
+ * @param turnsOut total heartbeats observed, may be NULL.
+ */
+void EventBase_stallStats(struct EventBase* eventBase,
+                          uint64_t* stallsOut,
+                          uint64_t* maxStallMsOut,
+                          uint64_t* turnsOut);
+
 #endif
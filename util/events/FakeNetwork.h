@@ -41,4 +41,16 @@ struct FakeNetwork* FakeNetwork_new(struct EventBase* base,
 struct FakeNetwork_UDPIface* FakeNetwork_iface(struct FakeNetwork* net,
                                                struct Sockaddr* bindAddress,
                                                struct Allocator* alloc);
+
+/**
+ * Degrade the simulated network: every message is dropped with
+ * lossPercent probability and survivors are delivered after
+ * latencyMs plus up to jitterMs of random extra delay (which also
+ * reorders traffic, as a real jittery path would). All zeros (the
+ * default) restores instant lossless delivery.
+ */
+void FakeNetwork_setConditions(struct FakeNetwork* net,
+                               uint32_t latencyMs,
+                               uint32_t jitterMs,
+                               uint32_t lossPercent);
 #endif
@@ -43,6 +43,24 @@ struct Timeout* Timeout__setTimeout(void (* const callback)(void* callbackContex
 #define Timeout_setTimeout(cb, cbc, ms, eb, alloc) \
     Timeout__setTimeout((cb), (cbc), (ms), (eb), (alloc), Gcc_SHORT_FILE, Gcc_LINE)
 
+/**
+ * Like Timeout_setTimeout() but the caller grants slack: the deadline is
+ * rounded up to a multiple of slackMs, so timeouts which share a slack class
+ * come due on the same tick and the loop wakes once for the lot. Use for
+ * deadlines which only need to be roughly on time (sweeps, maintenance).
+ */
+struct Timeout* Timeout__setTimeoutWithSlack(void (* const callback)(void* callbackContext),
+                                             void* const callbackContext,
+                                             const uint64_t milliseconds,
+                                             const uint32_t slackMilliseconds,
+                                             struct EventBase* eventBase,
+                                             struct Allocator* allocator,
+                                             char* file,
+                                             int line);
+#define Timeout_setTimeoutWithSlack(cb, cbc, ms, slackMs, eb, alloc) \
+    Timeout__setTimeoutWithSlack((cb), (cbc), (ms), (slackMs), (eb), (alloc), \
+                                 Gcc_SHORT_FILE, Gcc_LINE)
+
 /**
  * Create a new interval event.
  * This event will continue to be fired periodicly until it is cleared or its allocator is freed.
@@ -72,6 +90,23 @@ struct Timeout* Timeout__setInterval(void (* const callback)(void* callbackConte
  *                if an interval then the interval period will be changed.
  * @param milliseconds the new timeout time or interval period.
  */
+/** One live timer, for the audit RPC. */
+struct Timeout_AuditInfo
+{
+    const char* file;
+    int line;
+    uint64_t milliseconds;
+    int isInterval;
+    int isArmed;
+};
+
+/**
+ * List the live timers of an event base with the code location which set
+ * each one, up to max entries.
+ * @return the number of entries written.
+ */
+int Timeout_audit(struct EventBase* eventBase, struct Timeout_AuditInfo* out, int max);
+
 void Timeout_resetTimeout(struct Timeout* timeout,
                           const uint64_t milliseconds);
 
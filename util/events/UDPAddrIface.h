@@ -32,6 +32,9 @@ Linker_require("util/events/libuv/UDPAddrIface.c")
 /** Maximum number of bytes to hold in queue before dropping packets. */
 #define UDPAddrIface_MAX_QUEUE 16384
 
+/** Default number of datagrams pulled per syscall where the platform can batch. */
+#define UDPAddrIface_DEFAULT_BATCH 16
+
 struct UDPAddrIface
 {
     struct AddrIface generic;
@@ -51,6 +54,14 @@ Er_DEFUN(struct UDPAddrIface* UDPAddrIface_new(struct EventBase* eventBase,
 
 int UDPAddrIface_setDSCP(struct UDPAddrIface* iface, uint8_t dscp);
 
+/**
+ * Set the number of datagrams pulled off the socket per syscall (1 to disable
+ * batching). Only effective on platforms with recvmmsg(), a no-op elsewhere.
+ */
+void UDPAddrIface_setBatch(struct UDPAddrIface* iface, int batch);
+
+int UDPAddrIface_getBatch(struct UDPAddrIface* iface);
+
 int UDPAddrIface_setBroadcast(struct UDPAddrIface* iface, bool enable);
 
 int UDPAddrIface_getFd(struct UDPAddrIface*);
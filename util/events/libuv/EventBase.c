@@ -62,6 +62,40 @@ static void calibrateTime(struct EventBase_pvt* base)
     base->baseTime = (seconds * 1000) + milliseconds - uv_now(base->loop);
 }
 
+/**
+ * The stall tracer is a heartbeat timer: if it fires more than
+ * STALL_THRESHOLD_MS late then some callback run (IO, timer or close work)
+ * held the loop for at least that long. Lateness catches every stall source
+ * because nothing can run while a callback holds the loop.
+ */
+#define STALL_TIMER_MS 500
+#define STALL_THRESHOLD_MS 100
+
+static void stallOnTimer(uv_timer_t* handle, int status)
+{
+    struct EventBase_pvt* base = Identity_check((struct EventBase_pvt*) handle->data);
+    uint64_t now = uv_hrtime();
+    if (base->stallTimerLast) {
+        uint64_t elapsedMs = (now - base->stallTimerLast) / 1000000;
+        uint64_t lateMs = (elapsedMs > STALL_TIMER_MS) ? elapsedMs - STALL_TIMER_MS : 0;
+        base->stallSamples++;
+        if (lateMs > base->stallMaxMs) { base->stallMaxMs = lateMs; }
+        if (lateMs >= STALL_THRESHOLD_MS) { base->stallCount++; }
+    }
+    base->stallTimerLast = now;
+}
+
+void EventBase_stallStats(struct EventBase* eventBase,
+                          uint64_t* stallsOut,
+                          uint64_t* maxStallMsOut,
+                          uint64_t* turnsOut)
+{
+    struct EventBase_pvt* ctx = Identity_check((struct EventBase_pvt*) eventBase);
+    if (stallsOut) { *stallsOut = ctx->stallCount; }
+    if (maxStallMsOut) { *maxStallMsOut = ctx->stallMaxMs; }
+    if (turnsOut) { *turnsOut = ctx->stallSamples; }
+}
+
 struct EventBase* EventBase_new(struct Allocator* allocator)
 {
     struct Allocator* alloc = Allocator_child(allocator);
@@ -70,6 +104,11 @@ struct EventBase* EventBase_new(struct Allocator* allocator)
     base->alloc = alloc;
     Identity_set(base);
 
+    uv_timer_init(base->loop, &base->stallTimer);
+    base->stallTimer.data = base;
+    uv_timer_start(&base->stallTimer, stallOnTimer, STALL_TIMER_MS, STALL_TIMER_MS);
+    uv_unref((uv_handle_t*) &base->stallTimer);
+
     Allocator_onFree(alloc, onFree, base);
     calibrateTime(base);
     return &base->pub;
@@ -81,9 +120,22 @@ void EventBase_beginLoop(struct EventBase* eventBase)
 
     Assert_true(!ctx->running); // double begin
     ctx->running = 1;
+    ctx->stopRequested = 0;
 
-    // start the loop.
-    uv_run(ctx->loop, UV_RUN_DEFAULT);
+    if (!ctx->busyPollIterations) {
+        // start the loop.
+        uv_run(ctx->loop, UV_RUN_DEFAULT);
+    } else {
+        // Busy-poll mode: after every blocking wake, spin a few non-blocking
+        // passes so a burst is consumed without going back through the kernel
+        // for each wave. Costs idle CPU, for boxes which trade watts for
+        // latency.
+        while (!ctx->stopRequested && uv_run(ctx->loop, UV_RUN_ONCE)) {
+            for (int i = 0; i < ctx->busyPollIterations && !ctx->stopRequested; i++) {
+                uv_run(ctx->loop, UV_RUN_NOWAIT);
+            }
+        }
+    }
 
     ctx->running = 0;
 
@@ -97,9 +149,18 @@ void EventBase_beginLoop(struct EventBase* eventBase)
 void EventBase_endLoop(struct EventBase* eventBase)
 {
     struct EventBase_pvt* ctx = Identity_check((struct EventBase_pvt*) eventBase);
+    ctx->stopRequested = 1;
     uv_stop(ctx->loop);
 }
 
+void EventBase_setBusyPoll(struct EventBase* eventBase, int iterations)
+{
+    struct EventBase_pvt* ctx = Identity_check((struct EventBase_pvt*) eventBase);
+    if (iterations < 0) { iterations = 0; }
+    if (iterations > 1000) { iterations = 1000; }
+    ctx->busyPollIterations = iterations;
+}
+
 static void countCallback(uv_handle_t* event, void* vEventCount)
 {
     int* eventCount = (int*) vEventCount;
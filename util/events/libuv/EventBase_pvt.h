@@ -31,6 +31,12 @@ struct EventBase_pvt
     /** True if the loop is running. */
     int running;
 
+    /** Set by EventBase_endLoop(), checked by the busy-poll wrapper. */
+    int stopRequested;
+
+    /** Busy-poll spins after each blocking wake, see EventBase_setBusyPoll(). */
+    int busyPollIterations;
+
     /**
      * The onFree job which is passed from onFree() to EventLoop_begin()
      * so it can be completed after the loop has ended.
@@ -42,6 +48,21 @@ struct EventBase_pvt
 
     void* timeouts;
 
+    /** Stall tracer heartbeat timer, see EventBase_stallStats(). */
+    uv_timer_t stallTimer;
+
+    /** Hrtime (ns) when the heartbeat last fired. */
+    uint64_t stallTimerLast;
+
+    /** Number of heartbeats which arrived later than the stall threshold. */
+    uint64_t stallCount;
+
+    /** The longest observed heartbeat lateness in milliseconds. */
+    uint64_t stallMaxMs;
+
+    /** Total heartbeats observed. */
+    uint64_t stallSamples;
+
     Identity
 };
 
@@ -20,6 +20,7 @@
 #include "util/events/EventBase.h"
 #include "util/log/Log.h"
 #include "interface/ASynchronizer.h"
+#include "util/events/Timeout.h"
 #include "wire/Error.h"
 
 #define Map_USE_HASH
@@ -48,10 +49,47 @@ struct FakeNetwork_pvt
     struct Iface toAsync;
     uint16_t lastPort;
 
+    /** Simulated link conditions, see FakeNetwork_setConditions(). */
+    uint32_t latencyMs;
+    uint32_t jitterMs;
+    uint32_t lossPercent;
+    uint64_t rngState;
+
     struct Map_OfIfaces map;
     Identity
 };
 
+/** Holds one in-flight message while simulated latency elapses. */
+struct FakeNetwork_Delayed
+{
+    struct FakeNetwork_pvt* fnp;
+    struct Message* msg;
+    struct Allocator* alloc;
+    Identity
+};
+
+static uint32_t nextRand(struct FakeNetwork_pvt* fnp)
+{
+    // xorshift, only drives the simulation
+    uint64_t x = fnp->rngState;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    fnp->rngState = x;
+    return (uint32_t) x;
+}
+
+static void deliverDelayed(void* vDelayed)
+{
+    struct FakeNetwork_Delayed* d = Identity_check((struct FakeNetwork_Delayed*) vDelayed);
+    struct FakeNetwork_pvt* fnp = Identity_check(d->fnp);
+    struct RTypes_Error_t* err = Iface_send(&fnp->toAsync, d->msg);
+    if (err) {
+        Log_debug(fnp->log, "Failed to deliver delayed message");
+    }
+    Allocator_free(d->alloc);
+}
+
 struct FakeNetwork_UDPIface_pvt
 {
     struct FakeNetwork_UDPIface pub;
@@ -104,15 +142,47 @@ static Iface_DEFUN incoming(struct Message* msg, struct Iface* iface)
         Identity_check((struct FakeNetwork_UDPIface_pvt*) iface);
     struct FakeNetwork_pvt* fnp = Identity_check(fnip->fnp);
 
+    if (fnp->lossPercent && nextRand(fnp) % 100 < fnp->lossPercent) {
+        // the simulated wire ate it
+        return NULL;
+    }
+
     // Swap so that the message contains [dest][src][content]
     struct Sockaddr_storage dest;
     popSockaddr(msg, &dest);
     pushSockaddr(msg, fnip->pub.generic.addr);
     pushSockaddr(msg, &dest.addr);
 
+    if (fnp->latencyMs || fnp->jitterMs) {
+        uint64_t delay = fnp->latencyMs;
+        if (fnp->jitterMs) { delay += nextRand(fnp) % (fnp->jitterMs + 1); }
+        struct Allocator* dAlloc = Allocator_child(fnp->alloc);
+        Allocator_adopt(dAlloc, Message_getAlloc(msg));
+        struct FakeNetwork_Delayed* d =
+            Allocator_calloc(dAlloc, sizeof(struct FakeNetwork_Delayed), 1);
+        d->fnp = fnp;
+        d->msg = msg;
+        d->alloc = dAlloc;
+        Identity_set(d);
+        Timeout_setTimeout(deliverDelayed, d, delay, fnp->base, dAlloc);
+        return NULL;
+    }
+
     return Iface_next(&fnp->toAsync, msg);
 }
 
+void FakeNetwork_setConditions(struct FakeNetwork* net,
+                               uint32_t latencyMs,
+                               uint32_t jitterMs,
+                               uint32_t lossPercent)
+{
+    struct FakeNetwork_pvt* fnp = Identity_check((struct FakeNetwork_pvt*) net);
+    fnp->latencyMs = latencyMs;
+    fnp->jitterMs = jitterMs;
+    fnp->lossPercent = (lossPercent > 100) ? 100 : lossPercent;
+    if (!fnp->rngState) { fnp->rngState = 0x853c49e6748fea9bull; }
+}
+
 struct FakeNetwork_UDPIface* FakeNetwork_iface(struct FakeNetwork* net,
                                                struct Sockaddr* bindAddress,
                                                struct Allocator* allocator)
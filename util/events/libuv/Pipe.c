@@ -59,6 +59,22 @@ struct Pipe_pvt
     /** only non-null before the connection is setup. */
     struct Pipe_WriteRequest_pvt* bufferedRequest;
 
+    /**
+     * Only set for stream unix sockets (named/accepted pipes) whose payloads
+     * are self-framed. Never set for fds wrapped with Pipe_forFd: a tun
+     * device treats one write syscall as one packet, so merging messages
+     * into a single writev would concatenate packets.
+     */
+    int canBatch;
+
+    /** Outgoing messages parked to go out in one writev at the end of the loop turn. */
+    #define Pipe_BATCH_MAX 32
+    struct Pipe_WriteRequest_pvt* pending[Pipe_BATCH_MAX];
+    int pendingCount;
+
+    /** Flushes the pending messages, unreferenced so it never holds the loop open. */
+    uv_check_t sendFlusher;
+
     struct Allocator* alloc;
 
     struct Log* log;
@@ -74,6 +90,73 @@ struct Pipe_WriteRequest_pvt {
     Identity
 };
 
+/** One writev carrying a whole batch of parked messages. */
+struct Pipe_WriteBatch_pvt {
+    uv_write_t uvReq;
+    struct Pipe_pvt* pipe;
+    struct Allocator* alloc;
+    int count;
+    struct Pipe_WriteRequest_pvt* reqs[Pipe_BATCH_MAX];
+    Identity
+};
+
+static void batchWriteCallback(uv_write_t* uvReq, int error)
+{
+    struct Pipe_WriteBatch_pvt* batch = Identity_check((struct Pipe_WriteBatch_pvt*) uvReq);
+    struct Pipe_pvt* pipe = batch->pipe;
+    if (error) {
+        Log_info(pipe->log, "Failed to write to pipe [%s] [%s]",
+                 pipe->pub.fullName, uv_strerror(error) );
+    }
+    for (int i = 0; i < batch->count; i++) {
+        pipe->queueLen -= Message_getLength(batch->reqs[i]->msg);
+        Allocator_free(batch->reqs[i]->alloc);
+    }
+    Assert_ifParanoid(pipe->queueLen >= 0);
+    Allocator_free(batch->alloc);
+}
+
+static void flushPending(struct Pipe_pvt* pipe)
+{
+    const int count = pipe->pendingCount;
+    pipe->pendingCount = 0;
+    uv_check_stop(&pipe->sendFlusher);
+    if (!count) { return; }
+
+    struct Allocator* batchAlloc = Allocator_child(pipe->alloc);
+    struct Pipe_WriteBatch_pvt* batch =
+        Allocator_calloc(batchAlloc, sizeof(struct Pipe_WriteBatch_pvt), 1);
+    batch->pipe = pipe;
+    batch->alloc = batchAlloc;
+    batch->count = count;
+    Identity_set(batch);
+
+    uv_buf_t buffers[Pipe_BATCH_MAX];
+    for (int i = 0; i < count; i++) {
+        batch->reqs[i] = pipe->pending[i];
+        buffers[i].base = (char*) pipe->pending[i]->msg->msgbytes;
+        buffers[i].len = Message_getLength(pipe->pending[i]->msg);
+    }
+
+    int ret = uv_write(&batch->uvReq, (uv_stream_t*) &pipe->peer,
+                       buffers, count, batchWriteCallback);
+    if (ret) {
+        Log_info(pipe->log, "Failed writing to pipe [%s] [%s]",
+                 pipe->pub.fullName, uv_strerror(ret) );
+        for (int i = 0; i < count; i++) {
+            pipe->queueLen -= Message_getLength(batch->reqs[i]->msg);
+            Allocator_free(batch->reqs[i]->alloc);
+        }
+        Allocator_free(batchAlloc);
+    }
+}
+
+static void onSendFlush(uv_check_t* handle, int status)
+{
+    struct Pipe_pvt* pipe = Identity_check((struct Pipe_pvt*) handle->data);
+    flushPending(pipe);
+}
+
 static void sendMessageCallback(uv_write_t* uvReq, int error)
 {
     struct Pipe_WriteRequest_pvt* req = Identity_check((struct Pipe_WriteRequest_pvt*) uvReq);
@@ -146,7 +229,23 @@ static Iface_DEFUN sendMessage(struct Message* m, struct Iface* iface)
     Identity_set(req);
 
     if (pipe->isActive) {
-        sendMessage2(req);
+        // Messages carrying a file descriptor must travel alone (uv_write2),
+        // everything else on a batchable pipe is parked and goes out in one
+        // writev per loop turn.
+        if (!pipe->canBatch
+            || (pipe->ipc && Message_getAssociatedFd(m) > -1 && !Defined(win32)))
+        {
+            flushPending(pipe);
+            sendMessage2(req);
+        } else {
+            pipe->queueLen += Message_getLength(m);
+            pipe->pending[pipe->pendingCount++] = req;
+            if (pipe->pendingCount >= Pipe_BATCH_MAX) {
+                flushPending(pipe);
+            } else if (pipe->pendingCount == 1) {
+                uv_check_start(&pipe->sendFlusher, onSendFlush);
+            }
+        }
     } else {
         if (!pipe->bufferedRequest) {
             Log_debug(pipe->log, "Buffering a message");
@@ -172,7 +271,7 @@ static void onClose(uv_handle_t* handle)
 {
     struct Pipe_pvt* pipe = Identity_check((struct Pipe_pvt*)handle->data);
     handle->data = NULL;
-    if (pipe->closeHandlesOnFree && !pipe->peer.data) {
+    if (pipe->closeHandlesOnFree && !pipe->peer.data && !pipe->sendFlusher.data) {
         Allocator_onFreeComplete((struct Allocator_OnFreeJob*) pipe->closeHandlesOnFree);
     }
 }
@@ -297,11 +396,16 @@ static int closeHandlesOnFree(struct Allocator_OnFreeJob* job)
 {
     struct Pipe_pvt* pipe = Identity_check((struct Pipe_pvt*)job->userData);
     pipe->closeHandlesOnFree = job;
+    int async = 0;
     if (pipe->peer.data) {
         uv_close((uv_handle_t*) &pipe->peer, onClose);
-        return Allocator_ONFREE_ASYNC;
+        async = 1;
+    }
+    if (pipe->sendFlusher.data) {
+        uv_close((uv_handle_t*) &pipe->sendFlusher, onClose);
+        async = 1;
     }
-    return 0;
+    return (async) ? Allocator_ONFREE_ASYNC : 0;
 }
 
 static Er_DEFUN(struct Pipe_pvt* newPipeAny(struct EventBase* eb,
@@ -330,6 +434,10 @@ static Er_DEFUN(struct Pipe_pvt* newPipeAny(struct EventBase* eb,
         Er_raise(alloc, "uv_pipe_init() failed [%s]", uv_strerror(ret));
     }
 
+    uv_check_init(ctx->loop, &out->sendFlusher);
+    out->sendFlusher.data = out;
+    uv_unref((uv_handle_t*) &out->sendFlusher);
+
     Allocator_onFree(alloc, closeHandlesOnFree, out);
     Allocator_onFree(alloc, blockFreeInsideCallback, out);
 
@@ -367,6 +475,7 @@ Er_DEFUN(struct Pipe* Pipe_named(const char* fullPath,
                         struct Allocator* userAlloc))
 {
     struct Pipe_pvt* out = Er(newPipeAny(eb, fullPath, true, log, userAlloc));
+    out->canBatch = 1;
 
     uv_connect_t* req = Allocator_malloc(out->alloc, sizeof(uv_connect_t));
     req->data = out;
@@ -395,6 +504,7 @@ Er_DEFUN(struct Pipe* Pipe_serverAccept(uv_pipe_t* server,
                                struct Allocator* userAlloc))
 {
     struct Pipe_pvt* out = Er(newPipeAny(eb, NULL, true, log, userAlloc));
+    out->canBatch = 1;
     int ret = uv_accept((uv_stream_t*) server, (uv_stream_t*) &out->peer);
     if (ret) {
         uv_close((uv_handle_t*) &out->peer, onClose);
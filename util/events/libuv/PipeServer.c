@@ -41,10 +41,19 @@ struct Client
     struct PipeServer_pvt* psp;
     struct Allocator* alloc;
 
+    /** Consecutive sends refused because the client's pipe queue is full. */
+    uint32_t consecutiveOverflows;
+
     struct Sockaddr addr;
     Identity
 };
 
+/**
+ * A client whose queue refuses this many messages in a row is not reading;
+ * cut it loose rather than letting it silently eat responses forever.
+ */
+#define MAX_CONSECUTIVE_OVERFLOWS 32
+
 #define Map_NAME Clients
 #define Map_ENABLE_HANDLES
 #define Map_VALUE_TYPE struct Client*
@@ -82,7 +91,16 @@ static Iface_DEFUN sendMessage(struct Message* m, struct Iface* iface)
         return Error(m, "UNHANDLED");
     }
     struct Client* cli = psp->clients.values[idx];
-    return Iface_next(&cli->iface, m);
+    struct RTypes_Error_t* err = Iface_next(&cli->iface, m);
+    if (err) {
+        if (++cli->consecutiveOverflows >= MAX_CONSECUTIVE_OVERFLOWS) {
+            Log_warn(psp->log, "Client [0x%x] is not reading, disconnecting", handle);
+            Allocator_free(cli->alloc);
+        }
+    } else {
+        cli->consecutiveOverflows = 0;
+    }
+    return err;
 }
 
 static Iface_DEFUN incomingFromClient(struct Message* msg, struct Iface* iface)
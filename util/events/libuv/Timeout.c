@@ -31,6 +31,10 @@ struct Timeout
     uint16_t isInterval;
     uint16_t isArmed;
 
+    /** Which code set this timer, for the audit. */
+    const char* file;
+    int line;
+
     struct Allocator* alloc;
 
     struct Timeout* next;
@@ -124,6 +128,8 @@ static struct Timeout* setTimeout(void (* const callback)(void* callbackContext)
     timeout->alloc = alloc;
     timeout->isInterval = interval;
     timeout->base = base;
+    timeout->file = file;
+    timeout->line = line;
     Identity_set(timeout);
 
     uv_timer_init(base->loop, &timeout->timer);
@@ -150,6 +156,30 @@ struct Timeout* Timeout__setTimeout(void (* const callback)(void* callbackContex
     return setTimeout(callback, callbackContext, milliseconds, 0, eventBase, allocator, file, line);
 }
 
+/** See: Timeout.h */
+struct Timeout* Timeout__setTimeoutWithSlack(void (* const callback)(void* callbackContext),
+                                             void* const callbackContext,
+                                             const uint64_t milliseconds,
+                                             const uint32_t slackMilliseconds,
+                                             struct EventBase* eventBase,
+                                             struct Allocator* allocator,
+                                             char* file,
+                                             int line)
+{
+    uint64_t ms = milliseconds;
+    if (slackMilliseconds) {
+        // Round the absolute deadline up to a slack boundary so timeouts
+        // sharing a slack class come due together and one poll wake serves
+        // the whole batch.
+        struct EventBase_pvt* base = EventBase_privatize(eventBase);
+        const uint64_t now = uv_now(base->loop);
+        uint64_t due = now + milliseconds + slackMilliseconds - 1;
+        due -= due % slackMilliseconds;
+        ms = due - now;
+    }
+    return setTimeout(callback, callbackContext, ms, 0, eventBase, allocator, file, line);
+}
+
 /** See: Timeout.h */
 struct Timeout* Timeout__setInterval(void (* const callback)(void* callbackContext),
                                      void* const callbackContext,
@@ -196,4 +226,22 @@ void Timeout_clearAll(struct EventBase* eventBase)
 int Timeout_isActive(struct Timeout* timeout)
 {
     return (timeout && timeout->selfPtr);
-}
\ No newline at end of file
+}
+
+int Timeout_audit(struct EventBase* eventBase, struct Timeout_AuditInfo* out, int max)
+{
+    struct EventBase_pvt* base = EventBase_privatize(eventBase);
+    int count = 0;
+    for (struct Timeout* t = (struct Timeout*) base->timeouts;
+         t && count < max;
+         t = t->next)
+    {
+        out[count].file = t->file;
+        out[count].line = t->line;
+        out[count].milliseconds = t->milliseconds;
+        out[count].isInterval = t->isInterval;
+        out[count].isArmed = t->isArmed;
+        count++;
+    }
+    return count;
+}
@@ -12,6 +12,11 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
+#if defined(linux) && !defined(_GNU_SOURCE)
+    // for recvmmsg()/sendmmsg()
+    #define _GNU_SOURCE
+#endif
+
 #include "util/events/libuv/UvWrapper.h"
 #include "exception/Except.h"
 #include "interface/Iface.h"
@@ -25,6 +30,14 @@
 #include "wire/Error.h"
 #include "util/Hex.h"
 
+#ifdef linux
+    #include <sys/socket.h>
+    #include <errno.h>
+#endif
+
+/** Most datagrams which will be flushed in one sendmmsg() call. */
+#define UDPAddrIface_SEND_BATCH_MAX 64
+
 struct UDPAddrIface_pvt
 {
     struct UDPAddrIface pub;
@@ -42,6 +55,38 @@ struct UDPAddrIface_pvt
     uv_udp_t uvHandle;
     int queueLen;
 
+    /**
+     * Incoming messages are carved out of slabs of UDPAddrIface_BATCH_MESSAGES
+     * messages, each slab owned by one child allocator. The slab allocator is
+     * released once every message in it has been handed to a read callback;
+     * messages which are still in flight downstream (e.g. waiting on a TUN
+     * write) keep it alive by adoption. This amortizes the per-datagram
+     * allocator round trip across a whole batch.
+     */
+    struct Allocator* batchAlloc;
+    struct Message* batchMsgs;
+    uint8_t* batchBuff;
+    int batchRemaining;
+
+    /** Number of datagrams to pull per syscall, see UDPAddrIface_setBatch(). */
+    int recvBatch;
+
+    /** Number of uv handles whose close must complete before the allocator can go. */
+    int handlesToClose;
+
+    #ifdef linux
+        /** Outgoing messages waiting to be flushed in one sendmmsg() call. */
+        struct UDPAddrIface_SendEntry {
+            struct Message* msg;
+            struct Allocator* alloc;
+            struct Sockaddr_storage ss;
+        } sendQueue[UDPAddrIface_SEND_BATCH_MAX];
+        int sendQueueLen;
+
+        /** Flushes the send queue at the end of the loop turn. */
+        uv_check_t sendFlusher;
+    #endif
+
     /** true if we are inside of the callback, used by blockFreeInsideCallback */
     int inCallback;
 
@@ -78,6 +123,97 @@ static void sendComplete(uv_udp_send_t* uvReq, int error)
 }
 
 
+/**
+ * Send one message through the libuv send queue, taking ownership of reqAlloc.
+ * Returns non-zero on failure, in which case reqAlloc has been freed and the
+ * message must not be touched again (when called from the deferred flush, the
+ * original owner may have already dropped its reference).
+ */
+static int uvSend(struct UDPAddrIface_pvt* context,
+                  struct Message* m,
+                  struct Allocator* reqAlloc,
+                  struct Sockaddr_storage* ss)
+{
+    struct UDPAddrIface_WriteRequest_pvt* req =
+        Allocator_clone(reqAlloc, (&(struct UDPAddrIface_WriteRequest_pvt) {
+            .udp = context,
+            .msg = m,
+            .alloc = reqAlloc
+        }));
+    Identity_set(req);
+
+    req->length = Message_getLength(m);
+
+    uv_buf_t buffers[] = {
+        { .base = (char*)m->msgbytes, .len = Message_getLength(m) }
+    };
+
+    int ret = uv_udp_send(&req->uvReq, &context->uvHandle, buffers, 1,
+                (const struct sockaddr*)ss->nativeAddr, (uv_udp_send_cb)&sendComplete);
+
+    if (ret) {
+        Log_info(context->logger, "DROP Failed writing to UDPAddrIface [%s]",
+                 uv_strerror(ret));
+        context->queueLen -= Message_getLength(m);
+        Allocator_free(req->alloc);
+        return -1;
+    }
+
+    return 0;
+}
+
+#ifdef linux
+/**
+ * Flush every queued outgoing message with one sendmmsg() call.
+ * Whatever the kernel will not take immediately falls back to the libuv
+ * send queue which owns the socket's writability events.
+ */
+static void flushSendQueue(struct UDPAddrIface_pvt* context)
+{
+    const int count = context->sendQueueLen;
+    context->sendQueueLen = 0;
+    uv_check_stop(&context->sendFlusher);
+    if (!count) { return; }
+
+    struct iovec iovs[UDPAddrIface_SEND_BATCH_MAX];
+    struct mmsghdr vec[UDPAddrIface_SEND_BATCH_MAX];
+    for (int i = 0; i < count; i++) {
+        struct UDPAddrIface_SendEntry* entry = &context->sendQueue[i];
+        iovs[i].iov_base = entry->msg->msgbytes;
+        iovs[i].iov_len = Message_getLength(entry->msg);
+        Bits_memset(&vec[i], 0, sizeof(struct mmsghdr));
+        vec[i].msg_hdr.msg_name = entry->ss.nativeAddr;
+        vec[i].msg_hdr.msg_namelen = entry->ss.addr.addrLen - Sockaddr_OVERHEAD;
+        vec[i].msg_hdr.msg_iov = &iovs[i];
+        vec[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    int sent = sendmmsg(context->uvHandle.io_watcher.fd, vec, count, MSG_DONTWAIT);
+    if (sent < 0) { sent = 0; }
+
+    for (int i = 0; i < sent; i++) {
+        struct UDPAddrIface_SendEntry* entry = &context->sendQueue[i];
+        context->queueLen -= Message_getLength(entry->msg);
+        Allocator_free(entry->alloc);
+    }
+    Assert_true(context->queueLen >= 0);
+
+    // Socket would block, let libuv deal with the stragglers.
+    for (int i = sent; i < count; i++) {
+        struct UDPAddrIface_SendEntry* entry = &context->sendQueue[i];
+        if (uvSend(context, entry->msg, entry->alloc, &entry->ss)) {
+            Log_debug(context->logger, "Failed to flush message via libuv");
+        }
+    }
+}
+
+static void onSendFlush(uv_check_t* handle, int status)
+{
+    struct UDPAddrIface_pvt* context = Identity_check((struct UDPAddrIface_pvt*) handle->data);
+    flushSendQueue(context);
+}
+#endif
+
 static Iface_DEFUN incomingFromIface(struct Message* m, struct Iface* iface)
 {
     struct UDPAddrIface_pvt* context = Identity_check((struct UDPAddrIface_pvt*) iface);
@@ -99,36 +235,32 @@ static Iface_DEFUN incomingFromIface(struct Message* m, struct Iface* iface)
     struct Allocator* reqAlloc = Allocator_child(context->allocator);
     Allocator_adopt(reqAlloc, Message_getAlloc(m));
 
-    struct UDPAddrIface_WriteRequest_pvt* req =
-        Allocator_clone(reqAlloc, (&(struct UDPAddrIface_WriteRequest_pvt) {
-            .udp = context,
-            .msg = m,
-            .alloc = reqAlloc
-        }));
-    Identity_set(req);
-
     struct Sockaddr_storage ss;
     Er_assert(Message_epop(m, &ss, context->pub.generic.addr->addrLen));
     Assert_true(ss.addr.addrLen == context->pub.generic.addr->addrLen);
 
-    req->length = Message_getLength(m);
-
-    uv_buf_t buffers[] = {
-        { .base = (char*)m->msgbytes, .len = Message_getLength(m) }
-    };
-
-    int ret = uv_udp_send(&req->uvReq, &context->uvHandle, buffers, 1,
-                (const struct sockaddr*)ss.nativeAddr, (uv_udp_send_cb)&sendComplete);
-
-    if (ret) {
-        Log_info(context->logger, "DROP Failed writing to UDPAddrIface [%s]",
-                 uv_strerror(ret));
-        Allocator_free(req->alloc);
-        return Error(m, "UNHANDLED");
-    }
     context->queueLen += Message_getLength(m);
 
-    return NULL;
+    #ifdef linux
+        // Park the message in the send queue, it goes out in one sendmmsg() with
+        // everything else queued during this loop turn.
+        struct UDPAddrIface_SendEntry* entry = &context->sendQueue[context->sendQueueLen++];
+        entry->msg = m;
+        entry->alloc = reqAlloc;
+        Bits_memcpy(&entry->ss, &ss, sizeof(struct Sockaddr_storage));
+        if (context->sendQueueLen >= UDPAddrIface_SEND_BATCH_MAX) {
+            flushSendQueue(context);
+        } else if (context->sendQueueLen == 1) {
+            uv_check_start(&context->sendFlusher, onSendFlush);
+        }
+        return NULL;
+    #else
+        if (uvSend(context, m, reqAlloc, &ss)) {
+            // synchronous failure: the caller still owns the message allocator
+            return Error(m, "UNHANDLED");
+        }
+        return NULL;
+    #endif
 }
 
 #if UDPAddrIface_PADDING_AMOUNT < 8
@@ -136,6 +268,122 @@ static Iface_DEFUN incomingFromIface(struct Message* m, struct Iface* iface)
 #endif
 #define ALLOC(buff) (((struct Message**) &(buff[-(8 + (((uintptr_t)buff) % 8))]))[0])
 
+/** Number of messages per receive slab, about 64kB of buffer space. */
+#define BATCH_MESSAGES 16
+
+/** Per-message storage in a slab: padding, sockaddr space and the buffer itself. */
+static uint32_t messageSpace(struct UDPAddrIface_pvt* context)
+{
+    uint32_t space = UDPAddrIface_PADDING_AMOUNT
+        + context->pub.generic.addr->addrLen
+        + UDPAddrIface_BUFFER_CAP;
+    // keep each message's buffer 8 byte aligned within the slab
+    return (space + 7) & ~7u;
+}
+
+/** Hand out the next message from the current slab, cutting a new slab if needed. */
+static struct Message* getMessage(struct UDPAddrIface_pvt* context)
+{
+    if (context->batchAlloc && !context->batchRemaining) {
+        // Exhausted slab which was not released yet, drop our reference.
+        Allocator_free(context->batchAlloc);
+        context->batchAlloc = NULL;
+    }
+    if (!context->batchAlloc) {
+        struct Allocator* child = context->batchAlloc = Allocator_child(context->allocator);
+        context->batchBuff = Allocator_malloc(child, BATCH_MESSAGES * messageSpace(context));
+        context->batchMsgs = Allocator_calloc(child, sizeof(struct Message), BATCH_MESSAGES);
+        context->batchRemaining = BATCH_MESSAGES;
+    }
+
+    const uint32_t padding = UDPAddrIface_PADDING_AMOUNT + context->pub.generic.addr->addrLen;
+    const int idx = BATCH_MESSAGES - context->batchRemaining;
+    context->batchRemaining--;
+
+    uint8_t* buff = &context->batchBuff[idx * messageSpace(context)];
+    struct Message* msg = &context->batchMsgs[idx];
+    *msg = (struct Message) {
+        ._length = UDPAddrIface_BUFFER_CAP,
+        ._capacity = UDPAddrIface_BUFFER_CAP,
+        ._padding = padding,
+        .msgbytes = &buff[padding],
+        ._ad = buff,
+        ._alloc = context->batchAlloc
+    };
+
+    ALLOC(msg->msgbytes) = msg;
+    return msg;
+}
+
+/** Push the sockaddr onto an incoming message and send it up towards the switch. */
+static void dispatchMessage(struct UDPAddrIface_pvt* context,
+                            struct Message* msg,
+                            const struct sockaddr* addr)
+{
+    Er_assert(Message_epush(msg, addr, context->pub.generic.addr->addrLen - Sockaddr_OVERHEAD));
+
+    // make sure the sockaddr doesn't have crap in it which will
+    // prevent it from being used as a lookup key
+    Sockaddr_normalizeNative((struct sockaddr*) msg->msgbytes);
+
+    Er_assert(Message_epush(msg, context->pub.generic.addr, Sockaddr_OVERHEAD));
+
+    /*uint8_t buff[256] = {0};
+    Assert_true(Hex_encode(buff, 255, m->bytes, context->pub.generic.addr->addrLen));
+    Log_debug(context->logger, "Message from [%s]", buff);*/
+
+    Iface_send(&context->pub.generic.iface, msg);
+}
+
+#ifdef linux
+/**
+ * The socket probably has more datagrams queued than the one libuv just handed
+ * over, pull the rest out recvBatch at a time with recvmmsg() until it is dry.
+ */
+static void drainSocket(struct UDPAddrIface_pvt* context)
+{
+    const int fd = context->uvHandle.io_watcher.fd;
+    for (;;) {
+        int cnt = context->recvBatch;
+        if (cnt > BATCH_MESSAGES) { cnt = BATCH_MESSAGES; }
+        if (cnt < 2) { return; }
+
+        struct Message* msgs[BATCH_MESSAGES];
+        struct iovec iovs[BATCH_MESSAGES];
+        struct sockaddr_storage names[BATCH_MESSAGES];
+        struct mmsghdr vec[BATCH_MESSAGES];
+
+        // Stay inside the current slab so unreceived messages can be handed back.
+        if (context->batchAlloc && context->batchRemaining && cnt > context->batchRemaining) {
+            cnt = context->batchRemaining;
+        }
+        for (int i = 0; i < cnt; i++) {
+            msgs[i] = getMessage(context);
+            iovs[i].iov_base = msgs[i]->msgbytes;
+            iovs[i].iov_len = UDPAddrIface_BUFFER_CAP;
+            Bits_memset(&vec[i], 0, sizeof(struct mmsghdr));
+            vec[i].msg_hdr.msg_name = &names[i];
+            vec[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+            vec[i].msg_hdr.msg_iov = &iovs[i];
+            vec[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int num = recvmmsg(fd, vec, cnt, MSG_DONTWAIT, NULL);
+        if (num < 0) { num = 0; }
+
+        // hand the unused messages back to the slab
+        context->batchRemaining += cnt - num;
+
+        for (int i = 0; i < num; i++) {
+            Er_assert(Message_truncate(msgs[i], vec[i].msg_len));
+            dispatchMessage(context, msgs[i], (const struct sockaddr*) &names[i]);
+        }
+
+        if (num < cnt) { return; }
+    }
+}
+#endif
+
 static void incoming(uv_udp_t* handle,
                      ssize_t nread,
                      const uv_buf_t* buf,
@@ -156,23 +404,18 @@ static void incoming(uv_udp_t* handle,
 
     } else {
         Er_assert(Message_truncate(msg, nread));
-        Er_assert(Message_epush(msg, addr, context->pub.generic.addr->addrLen - Sockaddr_OVERHEAD));
-
-        // make sure the sockaddr doesn't have crap in it which will
-        // prevent it from being used as a lookup key
-        Sockaddr_normalizeNative((struct sockaddr*) msg->msgbytes);
-
-        Er_assert(Message_epush(msg, context->pub.generic.addr, Sockaddr_OVERHEAD));
-
-        /*uint8_t buff[256] = {0};
-        Assert_true(Hex_encode(buff, 255, m->bytes, context->pub.generic.addr->addrLen));
-        Log_debug(context->logger, "Message from [%s]", buff);*/
+        dispatchMessage(context, msg, addr);
 
-        Iface_send(&context->pub.generic.iface, msg);
+        #ifdef linux
+            drainSocket(context);
+        #endif
     }
 
-    if (msg) {
-        Allocator_free(Message_getAlloc(msg));
+    if (msg && !context->batchRemaining && context->batchAlloc) {
+        // Last message of the slab is in, drop our reference. If anything downstream
+        // adopted a message's allocator then the slab lives on until it lets go.
+        Allocator_free(context->batchAlloc);
+        context->batchAlloc = NULL;
     }
 
     context->inCallback = 0;
@@ -185,26 +428,19 @@ static void allocate(uv_handle_t* handle, size_t size, uv_buf_t* buf)
 {
     struct UDPAddrIface_pvt* context = ifaceForHandle((uv_udp_t*)handle);
 
-    size = UDPAddrIface_BUFFER_CAP;
-
-    struct Allocator* child = Allocator_child(context->allocator);
-    struct Message* msg = Message_new(
-        UDPAddrIface_BUFFER_CAP,
-        UDPAddrIface_PADDING_AMOUNT + context->pub.generic.addr->addrLen,
-        child
-    );
-
-    ALLOC(msg->msgbytes) = msg;
+    struct Message* msg = getMessage(context);
 
     buf->base = msg->msgbytes;
-    buf->len = size;
+    buf->len = UDPAddrIface_BUFFER_CAP;
 }
 
 static void onClosed(uv_handle_t* wasClosed)
 {
     struct UDPAddrIface_pvt* context =
         Identity_check((struct UDPAddrIface_pvt*) wasClosed->data);
-    Allocator_onFreeComplete((struct Allocator_OnFreeJob*) context->closeHandleOnFree);
+    if (--context->handlesToClose <= 0) {
+        Allocator_onFreeComplete((struct Allocator_OnFreeJob*) context->closeHandleOnFree);
+    }
 }
 
 static int closeHandleOnFree(struct Allocator_OnFreeJob* job)
@@ -212,7 +448,12 @@ static int closeHandleOnFree(struct Allocator_OnFreeJob* job)
     struct UDPAddrIface_pvt* context =
         Identity_check((struct UDPAddrIface_pvt*) job->userData);
     context->closeHandleOnFree = job;
+    context->handlesToClose = 1;
     uv_close((uv_handle_t*)&context->uvHandle, onClosed);
+    #ifdef linux
+        context->handlesToClose++;
+        uv_close((uv_handle_t*)&context->sendFlusher, onClosed);
+    #endif
     return Allocator_ONFREE_ASYNC;
 }
 
@@ -256,6 +497,20 @@ int UDPAddrIface_getFd(struct UDPAddrIface* iface)
     return out;
 }
 
+void UDPAddrIface_setBatch(struct UDPAddrIface* iface, int batch)
+{
+    struct UDPAddrIface_pvt* context = Identity_check((struct UDPAddrIface_pvt*) iface);
+    if (batch < 1) { batch = 1; }
+    if (batch > BATCH_MESSAGES) { batch = BATCH_MESSAGES; }
+    context->recvBatch = batch;
+}
+
+int UDPAddrIface_getBatch(struct UDPAddrIface* iface)
+{
+    struct UDPAddrIface_pvt* context = Identity_check((struct UDPAddrIface_pvt*) iface);
+    return context->recvBatch;
+}
+
 int UDPAddrIface_setBroadcast(struct UDPAddrIface* iface, bool enable)
 {
     struct UDPAddrIface_pvt* context = Identity_check((struct UDPAddrIface_pvt*) iface);
@@ -290,6 +545,14 @@ Er_DEFUN(struct UDPAddrIface* UDPAddrIface_new(struct EventBase* eventBase,
 
     uv_udp_init(base->loop, &context->uvHandle);
     context->uvHandle.data = context;
+    context->recvBatch = UDPAddrIface_DEFAULT_BATCH;
+
+    #ifdef linux
+        uv_check_init(base->loop, &context->sendFlusher);
+        context->sendFlusher.data = context;
+        // the flusher must not hold the loop open on its own
+        uv_unref((uv_handle_t*) &context->sendFlusher);
+    #endif
 
     int ret;
     void* native = Sockaddr_asNative(addr);
@@ -365,8 +365,12 @@ static Er_DEFUN(void addDeleteRoutes(int sock,
                             struct RouteInfo* ri,
                             struct Allocator* tempAlloc))
 {
-    struct Message* msg = Message_new(0, 512, tempAlloc);
+    // Route messages are batched: every component is 4-byte aligned so the
+    // nlmsghdr-led messages can be concatenated and flushed in one send()
+    // once the buffer approaches a page.
+    struct Message* msg = Message_new(0, 4096, tempAlloc);
     for (;ri;ri = ri->next) {
+        const int lengthBefore = Message_getLength(msg);
         struct IfIndexAttr ifa = {
             .rta = {
                 .rta_len = sizeof(struct IfIndexAttr),
@@ -390,16 +394,24 @@ static Er_DEFUN(void addDeleteRoutes(int sock,
         };
         Er(Message_epush(msg, &route, sizeof(struct rtmsg)));
         struct nlmsghdr hdr = {
-            .nlmsg_len = Message_getLength(msg) + sizeof(struct nlmsghdr),
+            .nlmsg_len = Message_getLength(msg) - lengthBefore + sizeof(struct nlmsghdr),
             .nlmsg_type = (delete) ? RTM_DELROUTE : RTM_NEWROUTE,
             .nlmsg_flags = NLM_F_REQUEST | ((delete) ? 0 : NLM_F_CREATE) // | NLM_F_ACK,
         };
         Er(Message_epush(msg, &hdr, sizeof(struct nlmsghdr)));
+        if (Message_getLength(msg) > 3000) {
+            ssize_t sz = send(sock, msg->msgbytes, Message_getLength(msg), 0);
+            if (sz < 0) {
+                Er_raise(tempAlloc, "send() -> %s", strerror(errno));
+            }
+            Message_reset(msg);
+        }
+    }
+    if (Message_getLength(msg)) {
         ssize_t sz = send(sock, msg->msgbytes, Message_getLength(msg), 0);
         if (sz < 0) {
             Er_raise(tempAlloc, "send() -> %s", strerror(errno));
         }
-        Message_reset(msg);
     }
     Er_ret();
 }
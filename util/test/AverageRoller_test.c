@@ -46,7 +46,7 @@ int main()
 
     const uint32_t windowSeconds = 3;
 
-    struct Allocator* allocator = MallocAllocator_new(4096);
+    struct Allocator* allocator = MallocAllocator_new(16384);
 
     struct EventBase* eventBase = EventBase_new(allocator);
 
@@ -69,6 +69,40 @@ int main()
         }
     }
 
+    // Percentiles: 90 fast entries (3) and 10 slow ones (1000) in one second.
+    // The buckets are power-of-two sized so the reported bounds are 3 and 1023.
+    struct AverageRoller_pvt* pctRoller =
+        (struct AverageRoller_pvt*) AverageRoller_new(windowSeconds, eventBase, allocator);
+    pctRoller->lastUpdateTime = 0;
+    for (uint32_t i = 0; i < 90; i++) {
+        AverageRoller_updateAtTime(&pctRoller->pub, 1, 3);
+    }
+    for (uint32_t i = 0; i < 10; i++) {
+        AverageRoller_updateAtTime(&pctRoller->pub, 1, 1000);
+    }
+    if (AverageRoller_getPercentile(&pctRoller->pub, 50) != 3
+        || AverageRoller_getPercentile(&pctRoller->pub, 90) != 3
+        || AverageRoller_getPercentile(&pctRoller->pub, 99) != 1023
+        || AverageRoller_getPercentile(&pctRoller->pub, 100) != 1023)
+    {
+        printf("percentiles wrong: p50 %u p90 %u p99 %u p100 %u\n",
+               AverageRoller_getPercentile(&pctRoller->pub, 50),
+               AverageRoller_getPercentile(&pctRoller->pub, 90),
+               AverageRoller_getPercentile(&pctRoller->pub, 99),
+               AverageRoller_getPercentile(&pctRoller->pub, 100));
+        ret = 1;
+    }
+
+    // The slow entries must age out of the window with the rest of the data.
+    for (uint32_t sec = 2; sec < 2 + windowSeconds; sec++) {
+        AverageRoller_updateAtTime(&pctRoller->pub, sec, 3);
+    }
+    if (AverageRoller_getPercentile(&pctRoller->pub, 99) != 3) {
+        printf("p99 after aging: expected 3, got %u\n",
+               AverageRoller_getPercentile(&pctRoller->pub, 99));
+        ret = 1;
+    }
+
     Allocator_free(allocator);
     return ret;
 }
@@ -0,0 +1,140 @@
+/* vim: set expandtab ts=4 sw=4: */
+/*
+ * You may redistribute this program and/or modify it under the terms of
+ * the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "memory/MallocAllocator.h"
+#include "switch/LabelSplicer.h"
+#include "util/Checksum.h"
+#include "util/Hash.h"
+#include "util/Hex.h"
+#include "util/events/Time.h"
+#include "util/Assert.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define Map_KEY_TYPE uint32_t
+#define Map_VALUE_TYPE uint32_t
+#define Map_NAME Bench
+#include "util/Map.h"
+
+/**
+ * Microbenchmarks over the hot primitives. The numbers are printed so CI
+ * logs carry a history to diff against; the iteration counts are small
+ * enough that the whole suite stays in the tens of milliseconds, scale up
+ * with CJDNS_BENCH for real measurements.
+ */
+
+static int scale(void)
+{
+    char* benchEnv = getenv("CJDNS_BENCH");
+    if (benchEnv) {
+        int s = atoi(benchEnv);
+        if (s > 0) { return s; }
+    }
+    return 1;
+}
+
+static void report(const char* name, uint64_t t0, uint64_t t1, uint64_t ops)
+{
+    printf("BENCH %-24s %8llu ns/op\n", name,
+           (unsigned long long) ((t1 - t0) / ((ops) ? ops : 1)));
+}
+
+static uint64_t sink = 0;
+
+static void benchChecksum(int mult)
+{
+    uint8_t buff[1500];
+    for (int i = 0; i < 1500; i++) { buff[i] = i * 7; }
+    const uint64_t ops = 2000ull * mult;
+    uint64_t t0 = Time_hrtime();
+    for (uint64_t i = 0; i < ops; i++) {
+        buff[0] = i;
+        sink += Checksum_engine_be(buff, 1500);
+    }
+    report("Checksum_engine(1500)", t0, Time_hrtime(), ops);
+}
+
+static void benchHash(int mult)
+{
+    uint8_t key[20];
+    for (int i = 0; i < 20; i++) { key[i] = i * 3; }
+    const uint64_t ops = 20000ull * mult;
+    uint64_t t0 = Time_hrtime();
+    for (uint64_t i = 0; i < ops; i++) {
+        key[0] = i;
+        sink += Hash_compute(key, 20);
+    }
+    report("Hash_compute(20)", t0, Time_hrtime(), ops);
+}
+
+static void benchSplice(int mult)
+{
+    uint64_t labels[64];
+    for (int i = 0; i < 64; i++) { labels[i] = (i * 0x9137) | 1; }
+    const uint64_t ops = 5000ull * mult;
+    uint64_t t0 = Time_hrtime();
+    for (uint64_t i = 0; i < ops; i++) {
+        LabelSplicer_spliceN(labels, 64, 0x15);
+        labels[i % 64] = (labels[i % 64] >> 20) | 1;
+    }
+    report("LabelSplicer_spliceN(64)", t0, Time_hrtime(), ops * 64);
+}
+
+static void benchHex(int mult)
+{
+    uint8_t in[256];
+    uint8_t out[520];
+    for (int i = 0; i < 256; i++) { in[i] = i; }
+    const uint64_t ops = 10000ull * mult;
+    uint64_t t0 = Time_hrtime();
+    for (uint64_t i = 0; i < ops; i++) {
+        in[0] = i;
+        sink += Hex_encode(out, sizeof(out), in, 256);
+    }
+    report("Hex_encode(256)", t0, Time_hrtime(), ops);
+}
+
+static void benchMap(int mult)
+{
+    struct Allocator* alloc = MallocAllocator_new(1 << 22);
+    struct Map_Bench* map = Map_Bench_new(alloc);
+    for (uint32_t i = 0; i < 1000; i++) {
+        uint32_t key = i * 0x9e3779b9u;
+        Map_Bench_put(&key, &i, map);
+    }
+    const uint64_t ops = 20000ull * mult;
+    uint64_t t0 = Time_hrtime();
+    for (uint64_t i = 0; i < ops; i++) {
+        uint32_t key = (i % 1000) * 0x9e3779b9u;
+        int idx = Map_Bench_indexForKey(&key, map);
+        Assert_true(idx >= 0);
+        sink += idx;
+    }
+    report("Map_indexForKey(1000)", t0, Time_hrtime(), ops);
+    Allocator_free(alloc);
+}
+
+int main()
+{
+    int mult = scale();
+    benchChecksum(mult);
+    benchHash(mult);
+    benchSplice(mult);
+    benchHex(mult);
+    benchMap(mult);
+    // keep the compiler honest
+    if (sink == 0x1234567812345678ull) { printf("\n"); }
+    return 0;
+}
@@ -83,6 +83,22 @@ static inline void test(uint8_t* bytes, int len, uint64_t num, uint8_t* buf)
 } while (0)
 // CHECKFILES_IGNORE expecting a ;
 
+static void bulkTest()
+{
+    uint8_t bytes[] = "\xAC\xFD\xAB\xCD\x01\xFE\xAB\xCD\xEF\x01";
+    struct VarInt_Iter iter = { .ptr = bytes, .end = &bytes[10], .start = bytes };
+    uint64_t out[8] = { 0 };
+    Assert_true(VarInt_popBulk(&iter, out, 8) == 4);
+    Assert_true(out[0] == 0xAC);
+    Assert_true(out[1] == 0xABCD);
+    Assert_true(out[2] == 0x01);
+    Assert_true(out[3] == 0xABCDEF01);
+
+    // truncated input must fail, not stop short
+    struct VarInt_Iter iter2 = { .ptr = bytes, .end = &bytes[7], .start = bytes };
+    Assert_true(VarInt_popBulk(&iter2, out, 8) == -1);
+}
+
 static void simpleTest()
 {
     TEST("\x00", 0x00);
@@ -95,6 +111,7 @@ static void simpleTest()
 int main()
 {
     simpleTest();
+    bulkTest();
     fidelityTest();
     return 0;
 }
\ No newline at end of file
@@ -15,12 +15,19 @@
 #include "wire/Message.h"
 #include "util/UniqueName.h"
 
+// The buffer is carved out of the same allocation as the message structure,
+// so it must stay aligned when placed directly behind it.
+Assert_compileTime(!(sizeof(struct Message) % 8));
+
 struct Message* Message_new(uint32_t messageLength,
                                           uint32_t amountOfPadding,
                                           struct Allocator* alloc)
 {
-    uint8_t* buff = Allocator_malloc(alloc, messageLength + amountOfPadding);
-    struct Message* out = Allocator_calloc(alloc, sizeof(struct Message), 1);
+    // one allocation for the structure, the padding and the buffer
+    struct Message* out =
+        Allocator_malloc(alloc, sizeof(struct Message) + amountOfPadding + messageLength);
+    Bits_memset(out, 0, sizeof(struct Message));
+    uint8_t* buff = (uint8_t*) &out[1];
     out->_ad = buff;
     out->_adLen = 0;
     out->msgbytes = &buff[amountOfPadding];
@@ -61,6 +61,10 @@ static const uint32_t Metric_SM_INCOMING =     0xff700000;
 // Outgoing message, some upper layer thinks this is the path
 static const uint32_t Metric_SM_SEND =         0xff710000;
 
+// Path hint imported from a previous run, unverified, any live source of
+// truth will immediately override it
+static const uint32_t Metric_RESUME_HINT =     0xfff00000;
+
 // We have no information about this path, but we don't know it to be dead
 static const uint32_t Metric_NO_INFO =         0xfffffffe;
 